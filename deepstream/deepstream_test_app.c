@@ -327,7 +327,10 @@ create_stream_sink (guint stream_id, GstElement *pipeline)
   g_object_set(G_OBJECT(sink_info->dsexample),
                 "unique-id", stream_id + 15,        // Unique ID per stream
                 "vlm-enabled", TRUE,                // Enable VLM for each stream
-                "vlm-queue-size", 10,               // Individual queue per stream
+                "vlm-shared-dispatcher", TRUE,      // One worker/Redis pool for all streams
+                "vlm-workers", 4,                   // Shared worker threads
+                "vlm-queue-size", 256,              // Shared queue across streams
+                "vlm-source-queue-size", 10,        // Per-stream cap in the shared queue
                 "vlm-frame-interval", 30,           // Process every 30th frame
                 "processing-width", 640,
                 "processing-height", 480,
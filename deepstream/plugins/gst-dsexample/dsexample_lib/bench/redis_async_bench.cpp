@@ -0,0 +1,133 @@
+/*
+ * XADD throughput of RedisAsyncClient while a blocking XREADGROUP is pending.
+ *
+ * A consumer-group read with BLOCK sits on an empty stream while XADDs go to
+ * another stream through the same client. With the reads on their own
+ * connection the XADDs finish long before the read times out; the report
+ * says whether the read was still pending when the last XADD was answered.
+ * The read is then woken by one XADD to its stream, and the time until its
+ * future is ready is printed. For comparison, the same sequence on a single
+ * RedisClient shows one XADD queued behind the blocked read.
+ *
+ * Build and run:
+ *   g++ -O2 -std=c++17 -pthread -I.. redis_async_bench.cpp -lhiredis \
+ *       -o redis_async_bench
+ *   ./redis_async_bench [xadds] [block-ms] [host] [port]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "redis_async_client.h"
+#include "redis_client.h"
+
+static const char *kReadStream = "vlm:bench:async:read";
+static const char *kWriteStream = "vlm:bench:async:write";
+static const char *kGroup = "bench";
+
+static double ms_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+static std::map<std::string, std::string> result_fields(int i) {
+  return {
+      {"frame_number", std::to_string(i)},
+      {"source_id", "0"},
+      {"vlm_response", "A car is driving on the highway in light traffic."},
+      {"model_name", "bench"},
+      {"timestamp", "1700000000000"},
+      {"type", "vlm_result"},
+  };
+}
+
+static bool future_pending(const std::future<std::vector<StreamMessage>> &f) {
+  return f.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+// XADDs, all in flight at once, while a read blocks on the other connection
+static bool run_async(const std::string &host, int port, int n,
+    int block_ms) {
+  RedisAsyncClient client(host, port);
+  if (!client.usable()) {
+    printf("async: client unusable\n");
+    return false;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto read = client.xreadgroup(kGroup, "c1", kReadStream, 1, block_ms);
+
+  std::vector<std::future<std::string>> ids;
+  ids.reserve(n);
+  auto xadd_start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; ++i) {
+    ids.push_back(client.xadd(kWriteStream, result_fields(i)));
+  }
+  int failed = 0;
+  for (auto &id : ids) {
+    failed += id.get().empty();
+  }
+  double xadd_ms = ms_since(xadd_start);
+  bool pending = future_pending(read);
+
+  auto wake_start = std::chrono::steady_clock::now();
+  client.xadd(kReadStream, result_fields(0)).get();
+  size_t delivered = read.get().size();
+  double wake_ms = ms_since(wake_start);
+
+  printf("async: %d XADDs in %.1f ms (%.1f us each, %d failed), "
+      "read still blocked: %s\n", n, xadd_ms, xadd_ms * 1000.0 / n, failed,
+      pending ? "yes" : "no");
+  printf("async: read woken %.2f ms after the XADD to its stream "
+      "(%zu message, %.1f ms after it was issued)\n", wake_ms, delivered,
+      ms_since(start));
+  return failed == 0 && pending && delivered == 1;
+}
+
+// One synchronous client: the XADD has to wait for the read to return
+static void run_sync(const std::string &host, int port, int block_ms) {
+  RedisClient client(host, port);
+  if (!client.connect()) {
+    printf("sync: cannot connect\n");
+    return;
+  }
+  auto reader = std::async(std::launch::async, [&] {
+    return client.xreadgroup(kGroup, "c2", kReadStream, 1, block_ms);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  auto start = std::chrono::steady_clock::now();
+  client.xadd(kWriteStream, result_fields(0));
+  printf("sync:  1 XADD on the same client took %.1f ms (read blocks %d ms)\n",
+      ms_since(start), block_ms);
+  reader.get();
+}
+
+int main(int argc, char **argv) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int block_ms = argc > 2 ? std::atoi(argv[2]) : 1000;
+  std::string host = argc > 3 ? argv[3] : "localhost";
+  int port = argc > 4 ? std::atoi(argv[4]) : 6379;
+
+  RedisClient admin(host, port);
+  if (!admin.connect()) {
+    printf("cannot connect to %s:%d\n", host.c_str(), port);
+    return 1;
+  }
+  admin.del(kReadStream);
+  admin.del(kWriteStream);
+  admin.xgroup_create(kReadStream, kGroup, "$");
+
+  bool ok = run_async(host, port, n, block_ms);
+  run_sync(host, port, block_ms);
+
+  admin.del(kReadStream);
+  admin.del(kWriteStream);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+/*
+ * Round-trip latency of RedisClient over TCP and a Unix socket.
+ *
+ * Times PING and a single XADD (the fields VLMRedisStreamManager writes per
+ * result) one command at a time, reporting p50/p99/max. Runs over TCP with
+ * TCP_NODELAY on and off, and over the Unix socket when one is given. Entries
+ * go to a scratch stream that is deleted afterwards.
+ *
+ * Build and run (redis-server with `unixsocket` set for the socket case):
+ *   g++ -O2 -std=c++17 -pthread -I.. redis_latency_bench.cpp -lhiredis \
+ *       -o redis_latency_bench
+ *   ./redis_latency_bench [commands] [host] [port] [unix-socket]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "redis_client.h"
+
+static const char *kStream = "vlm:bench:latency";
+
+struct Percentiles {
+  double p50_us;
+  double p99_us;
+  double max_us;
+};
+
+static Percentiles summarize(std::vector<double> &samples) {
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](double q) {
+    return samples[std::min(samples.size() - 1, (size_t)(q * samples.size()))];
+  };
+  return {at(0.50), at(0.99), samples.back()};
+}
+
+// Times `command` `n` times after a short warm-up; false if any call failed
+template <typename Command>
+static bool measure(int n, Command command, Percentiles &out) {
+  for (int i = 0; i < std::min(n, 1000); ++i) {
+    command(i);
+  }
+  std::vector<double> samples;
+  samples.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    if (!command(i)) {
+      return false;
+    }
+    samples.push_back(std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count());
+  }
+  out = summarize(samples);
+  return true;
+}
+
+static void run(const char *name, const std::string &host, int port,
+    const RedisConnectionOptions &options, int n) {
+  RedisClient client(host, port);
+  client.set_connection_options(options);
+  if (!client.connect()) {
+    printf("%-14s cannot connect to %s\n", name,
+        options.describe(host, port).c_str());
+    return;
+  }
+
+  Percentiles ping, xadd;
+  bool ok = measure(n, [&](int) { return client.ping(); }, ping);
+  ok = ok && measure(n, [&](int i) {
+    std::string frame = std::to_string(i);
+    StreamFieldView fields[] = {
+        {"frame_number", frame},
+        {"source_id", "0"},
+        {"vlm_response", "A car is driving on the highway in light traffic."},
+        {"model_name", "bench"},
+        {"timestamp", "1700000000000"},
+        {"type", "vlm_result"},
+    };
+    return !client.xadd(kStream, fields).empty();
+  }, xadd);
+  client.del(kStream);
+  if (!ok) {
+    printf("%-14s command failed\n", name);
+    return;
+  }
+  printf("%-14s %9.1f %9.1f %9.1f   %9.1f %9.1f %9.1f\n", name, ping.p50_us,
+      ping.p99_us, ping.max_us, xadd.p50_us, xadd.p99_us, xadd.max_us);
+}
+
+int main(int argc, char **argv) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+  std::string host = argc > 2 ? argv[2] : "localhost";
+  int port = argc > 3 ? std::atoi(argv[3]) : 6379;
+  std::string socket = argc > 4 ? argv[4] : "";
+
+  printf("%-14s %29s   %29s\n", "", "PING p50/p99/max (us)",
+      "XADD p50/p99/max (us)");
+
+  RedisConnectionOptions tcp;
+  run("tcp", host, port, tcp, n);
+
+  RedisConnectionOptions nagle;
+  nagle.tcp_nodelay = false;
+  run("tcp no-nodelay", host, port, nagle, n);
+
+  if (!socket.empty()) {
+    RedisConnectionOptions unix_socket;
+    unix_socket.unix_socket = socket;
+    run("unix", host, port, unix_socket, n);
+  }
+  return 0;
+}
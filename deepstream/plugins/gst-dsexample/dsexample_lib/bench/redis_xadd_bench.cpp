@@ -0,0 +1,129 @@
+/*
+ * XADD throughput against a local redis-server.
+ *
+ * Compares RedisClient::xadd (one blocking round trip per entry under the
+ * client mutex) with RedisPipelinedWriter (entries batched into one round
+ * trip) for 1, 4 and 16 publishing threads, using the same fields as
+ * VLMRedisStreamManager::add_vlm_result. "writer-sync" waits on each
+ * pipelined entry before queuing the next, as a blocking call routed
+ * through the writer would. Entries go to a scratch stream that is deleted
+ * afterwards.
+ *
+ * Build and run (redis-server listening on host:port):
+ *   g++ -O2 -std=c++17 -pthread -I.. redis_xadd_bench.cpp -lhiredis \
+ *       -o redis_xadd_bench
+ *   ./redis_xadd_bench [entries-per-thread] [batch] [host] [port]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "redis_client.h"
+
+static const char *kStream = "vlm:bench:xadd";
+
+static std::map<std::string, std::string> make_fields(int thread, int i) {
+  return {
+      {"frame_number", std::to_string(i)},
+      {"source_id", std::to_string(thread)},
+      {"vlm_response", "A car is driving on the highway in light traffic."},
+      {"model_name", "bench"},
+      {"timestamp", "1700000000000"},
+      {"type", "vlm_result"},
+  };
+}
+
+struct BenchResult {
+  double entries_per_s;
+  uint64_t failures;
+};
+
+static BenchResult run_blocking(RedisClient &client, int threads, int entries) {
+  std::atomic<uint64_t> failures{0};
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < entries; ++i) {
+        if (client.xadd(kStream, make_fields(t, i)).empty()) {
+          failures++;
+        }
+      }
+    });
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+  double s = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  return {threads * entries / s, failures.load()};
+}
+
+// With wait_each, every entry is waited on before the next is queued
+static BenchResult run_pipelined(RedisPipelinedWriter &writer, int threads,
+    int entries, bool wait_each) {
+  std::atomic<uint64_t> failures{0};
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::vector<std::future<std::string>> ids;
+      ids.reserve(entries);
+      for (int i = 0; i < entries; ++i) {
+        ids.push_back(writer.xadd(kStream, make_fields(t, i)));
+        if (wait_each) {
+          ids.back().wait();
+        }
+      }
+      for (auto &id : ids) {
+        if (id.get().empty()) {
+          failures++;
+        }
+      }
+    });
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+  double s = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  return {threads * entries / s, failures.load()};
+}
+
+int main(int argc, char **argv) {
+  int entries = argc > 1 ? std::atoi(argv[1]) : 20000;
+  size_t batch = argc > 2 ? std::atoi(argv[2]) : 64;
+  std::string host = argc > 3 ? argv[3] : "localhost";
+  int port = argc > 4 ? std::atoi(argv[4]) : 6379;
+
+  RedisClient client(host, port);
+  if (!client.connect()) {
+    fprintf(stderr, "cannot connect to redis at %s:%d\n", host.c_str(), port);
+    return 1;
+  }
+
+  printf("%-8s %-11s %14s %10s\n", "threads", "mode", "entries/s", "failures");
+  for (int threads : {1, 4, 16}) {
+    auto r = run_blocking(client, threads, entries);
+    printf("%-8d %-11s %14.0f %10llu\n", threads, "blocking", r.entries_per_s,
+        (unsigned long long) r.failures);
+
+    for (bool wait_each : {true, false}) {
+      RedisPipelinedWriter writer(host, port, batch);
+      r = run_pipelined(writer, threads, entries, wait_each);
+      auto stats = writer.stats();
+      printf("%-8d %-11s %14.0f %10llu   (%.1f entries/round trip)\n", threads,
+          wait_each ? "writer-sync" : "pipelined", r.entries_per_s,
+          (unsigned long long) r.failures,
+          stats.flushes ? (double) stats.commands / stats.flushes : 0.0);
+    }
+  }
+
+  client.del(kStream);
+  return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Cost of the scene-change gate per sampled frame.
+ *
+ * Times SceneThumbnailFromRGB on an RGBA frame at the default processing
+ * resolution, and SceneSAD against SceneSADScalar on thumbnail-sized and
+ * frame-sized buffers. The gate runs the thumbnail and one thumbnail SAD
+ * for every sampled frame.
+ *
+ * Build and run:
+ *   gcc -O2 -c ../scene_change.c -o scene_change.o
+ *   g++ -O2 -std=c++17 -I.. scene_change_bench.cpp scene_change.o \
+ *       -o scene_change_bench
+ *   ./scene_change_bench [width] [height]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "scene_change.h"
+
+template <typename Fn>
+static double time_us(int iterations, Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    fn();
+  }
+  return std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void bench_sad(const char *name, const std::vector<unsigned char> &a,
+    const std::vector<unsigned char> &b, int iterations) {
+  volatile unsigned long sink = 0;
+  double simd = time_us(iterations, [&] {
+    sink = sink + SceneSAD(a.data(), b.data(), a.size());
+  });
+  double scalar = time_us(iterations, [&] {
+    sink = sink + SceneSADScalar(a.data(), b.data(), a.size());
+  });
+  printf("%-22s %9zu %11.2f %11.2f %8.1fx\n", name, a.size(), simd, scalar,
+      scalar / simd);
+}
+
+int main(int argc, char **argv) {
+  int width = argc > 1 ? std::atoi(argv[1]) : 640;
+  int height = argc > 2 ? std::atoi(argv[2]) : 480;
+
+  std::vector<unsigned char> frame((size_t)width * height * 4);
+  for (size_t i = 0; i < frame.size(); ++i) {
+    frame[i] = (unsigned char)(i * 2654435761u >> 24);
+  }
+  SceneThumbnail thumbnail;
+  double thumb_us = time_us(200, [&] {
+    SceneThumbnailFromRGB(&thumbnail, frame.data(), width, height, width * 4, 4);
+  });
+  printf("SceneThumbnailFromRGB %dx%d RGBA: %.1f us\n\n", width, height,
+      thumb_us);
+
+  char header[32];
+  snprintf(header, sizeof(header), "SAD (%s)", SceneSADKernel());
+  printf("%-22s %9s %11s %11s %9s\n", header, "bytes", "kernel us",
+      "scalar us", "speedup");
+  std::vector<unsigned char> a(SCENE_THUMB_PIXELS), b(SCENE_THUMB_PIXELS);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = (unsigned char)(i * 7);
+    b[i] = (unsigned char)(i * 13);
+  }
+  bench_sad("thumbnail", a, b, 200000);
+  std::vector<unsigned char> frame2(frame.rbegin(), frame.rend());
+  bench_sad("full frame", frame, frame2, 200);
+  return 0;
+}
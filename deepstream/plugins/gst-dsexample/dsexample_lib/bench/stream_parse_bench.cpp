@@ -0,0 +1,191 @@
+/*
+ * Parse cost of XRANGE replies.
+ *
+ * Builds a synthetic XRANGE reply shaped like vlm:results:stream entries
+ * (six fields each) and compares RedisClient::parse_xrange_reply (a
+ * StreamMessage with a std::map per entry) against StreamReply (views into
+ * the reply), then full scans reading three numeric fields per entry by
+ * name, through StreamSchema and as columns. Reports time and heap
+ * allocations per parse. No Redis server is needed.
+ *
+ * Build and run:
+ *   g++ -O2 -std=c++17 -pthread -I.. stream_parse_bench.cpp -lhiredis \
+ *       -o stream_parse_bench
+ *   ./stream_parse_bench [entries] [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "redis_client.h"
+
+static std::atomic<uint64_t> g_allocations{0};
+
+void *operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// Reply tree owned by the benchmark; never passed to freeReplyObject.
+class SyntheticReply {
+ public:
+  explicit SyntheticReply(size_t entries) {
+    root_ = array(entries);
+    for (size_t i = 0; i < entries; ++i) {
+      redisReply *entry = array(2);
+      std::string id = std::to_string(1700000000000ULL + i) + "-0";
+      entry->element[0] = string(id);
+      redisReply *kv = array(12);
+      const char *keys[] = {"frame_number", "source_id", "vlm_response",
+          "model_name", "timestamp", "type"};
+      std::string values[] = {std::to_string(i), std::to_string(i % 16),
+          "A car is driving on the highway in light traffic.",
+          "deepstream_vlm_v1", std::to_string(1700000000000ULL + i),
+          "vlm_result"};
+      for (int f = 0; f < 6; ++f) {
+        kv->element[2 * f] = string(keys[f]);
+        kv->element[2 * f + 1] = string(values[f]);
+      }
+      entry->element[1] = kv;
+      root_->element[i] = entry;
+    }
+  }
+
+  ~SyntheticReply() {
+    for (redisReply *r : nodes_) {
+      std::free(r->str);
+      std::free(r->element);
+      std::free(r);
+    }
+  }
+
+  redisReply *get() const { return root_; }
+
+ private:
+  redisReply *array(size_t n) {
+    auto *r = (redisReply *) std::calloc(1, sizeof(redisReply));
+    r->type = REDIS_REPLY_ARRAY;
+    r->elements = n;
+    r->element = (redisReply **) std::calloc(n, sizeof(redisReply *));
+    nodes_.push_back(r);
+    return r;
+  }
+
+  redisReply *string(const std::string &s) {
+    auto *r = (redisReply *) std::calloc(1, sizeof(redisReply));
+    r->type = REDIS_REPLY_STRING;
+    r->len = s.size();
+    r->str = (char *) std::malloc(s.size() + 1);
+    std::memcpy(r->str, s.c_str(), s.size() + 1);
+    nodes_.push_back(r);
+    return r;
+  }
+
+  redisReply *root_ = nullptr;
+  std::vector<redisReply *> nodes_;
+};
+
+template <typename Fn>
+static void run(const char *name, int iterations, size_t entries, Fn &&fn) {
+  uint64_t checksum = 0;
+  uint64_t allocations = g_allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum += fn();
+  }
+  double us = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+  double allocs = (double) (g_allocations.load() - allocations) / iterations;
+  printf("%-14s %12.1f %14.1f %14.2f   (checksum %llu)\n", name, us, allocs,
+      allocs / entries, (unsigned long long) checksum);
+}
+
+int main(int argc, char **argv) {
+  size_t entries = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+  SyntheticReply reply(entries);
+  // Non-owning handle: the tree belongs to SyntheticReply
+  std::shared_ptr<redisReply> borrowed(reply.get(), [](redisReply *) {});
+
+  printf("%zu entries x 6 fields\n", entries);
+  printf("%-14s %12s %14s %14s\n", "parser", "us/parse", "allocs/parse",
+      "allocs/entry");
+  run("StreamMessage", iterations, entries, [&] {
+    auto messages = RedisClient::parse_xrange_reply(reply.get());
+    uint64_t sum = 0;
+    for (const auto &msg : messages) {
+      sum += msg.get_field_as<uint32_t>("source_id");
+    }
+    return sum;
+  });
+  run("StreamReply", iterations, entries, [&] {
+    StreamReply messages = StreamReply::from_xrange(borrowed);
+    uint64_t sum = 0;
+    for (const auto &msg : messages) {
+      sum += msg.get_field_as<uint32_t>("source_id");
+    }
+    return sum;
+  });
+
+  // Scans reading three numeric columns per entry
+  printf("\n%-14s %12s %14s %14s\n", "3-column scan", "us/parse", "allocs/parse",
+      "allocs/entry");
+  run("StreamMessage", iterations, entries, [&] {
+    auto messages = RedisClient::parse_xrange_reply(reply.get());
+    uint64_t sum = 0;
+    for (const auto &msg : messages) {
+      sum += msg.get_field_as<uint32_t>("frame_number") +
+          msg.get_field_as<uint32_t>("source_id") +
+          msg.get_field_as<uint64_t>("timestamp");
+    }
+    return sum;
+  });
+  run("StreamReply", iterations, entries, [&] {
+    StreamReply messages = StreamReply::from_xrange(borrowed);
+    uint64_t sum = 0;
+    for (const auto &msg : messages) {
+      sum += msg.get_field_as<uint32_t>("frame_number") +
+          msg.get_field_as<uint32_t>("source_id") +
+          msg.get_field_as<uint64_t>("timestamp");
+    }
+    return sum;
+  });
+  StreamSchema schema{"frame_number", "source_id", "timestamp"};
+  run("StreamSchema", iterations, entries, [&] {
+    StreamReply messages = StreamReply::from_xrange(borrowed);
+    uint64_t sum = 0;
+    for (const auto &msg : messages) {
+      sum += schema.get_as<uint32_t>(msg, 0).value_or(0) +
+          schema.get_as<uint32_t>(msg, 1).value_or(0) +
+          schema.get_as<uint64_t>(msg, 2).value_or(0);
+    }
+    return sum;
+  });
+  std::vector<uint32_t> frames, sources;
+  std::vector<uint64_t> timestamps;
+  run("columnar", iterations, entries, [&] {
+    StreamReply messages = StreamReply::from_xrange(borrowed);
+    schema.extract(messages, 0, frames);
+    schema.extract(messages, 1, sources);
+    schema.extract(messages, 2, timestamps);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+      sum += frames[i] + sources[i] + timestamps[i];
+    }
+    return sum;
+  });
+  return 0;
+}
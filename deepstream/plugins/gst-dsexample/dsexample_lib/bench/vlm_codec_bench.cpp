@@ -0,0 +1,118 @@
+/*
+ * Size and cost of the compact VLM result encoding.
+ *
+ * Encodes VLM results of several response lengths both ways: the six
+ * string fields written by VLMRedisStreamManager::add_vlm_result, and one
+ * VLMResultCodec blob. Reports the XADD command size on the wire (RESP),
+ * the field bytes Redis stores per entry, and encode/decode time. No Redis
+ * server is needed.
+ *
+ * Build and run (add -DWITH_ZSTD ... -lzstd / -DWITH_LZ4 ... -llz4 to
+ * include compression):
+ *   g++ -O2 -std=c++17 -pthread -I.. vlm_codec_bench.cpp -lhiredis \
+ *       -o vlm_codec_bench
+ *   ./vlm_codec_bench [iterations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "redis_client.h"
+
+// Bytes of "*<argc>\r\n" followed by "$<len>\r\n<arg>\r\n" per argument
+static size_t resp_size(const std::vector<std::string_view> &args) {
+  size_t size = 3 + std::to_string(args.size()).size();
+  for (std::string_view arg : args) {
+    size += 5 + std::to_string(arg.size()).size() + arg.size();
+  }
+  return size;
+}
+
+static std::string make_response(size_t length) {
+  static const char *kWords[] = {"a", "car", "is", "driving", "on", "the",
+      "highway", "in", "light", "traffic", "while", "pedestrian", "waits",
+      "near", "crosswalk", "and", "truck", "turns", "left", "."};
+  std::string response;
+  unsigned seed = 7;
+  while (response.size() < length) {
+    seed = seed * 1103515245u + 12345u;
+    response += kWords[(seed >> 16) % 20];
+    response += ' ';
+  }
+  response.resize(length);
+  return response;
+}
+
+static void run(const char *name, const VLMResultCodec &codec,
+    const std::string &response, int iterations) {
+  std::map<std::string, std::string> plain = {
+      {"frame_number", "123456"},
+      {"source_id", "7"},
+      {"vlm_response", response},
+      {"model_name", "nvidia/cosmos-reason1"},
+      {"timestamp", "1700000000000"},
+      {"type", "vlm_result"},
+  };
+  std::vector<std::string_view> plain_args = {"XADD", "vlm:results:stream", "*"};
+  size_t plain_stored = 0;
+  for (const auto &[key, value] : plain) {
+    plain_args.push_back(key);
+    plain_args.push_back(value);
+    plain_stored += key.size() + value.size();
+  }
+
+  uint32_t model_id = vlm_model_id("nvidia/cosmos-reason1");
+  std::string blob;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    codec.encode(123456, 7, model_id, response, blob);
+  }
+  double encode_us = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  VLMResultRecord record;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    if (!VLMResultCodec::decode(blob, record)) {
+      std::fprintf(stderr, "decode failed\n");
+      std::exit(1);
+    }
+  }
+  double decode_us = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  size_t compact_wire = resp_size(
+      {"XADD", "vlm:results:stream", "*", VLMResultCodec::kField, blob});
+  size_t compact_stored =
+      std::string_view(VLMResultCodec::kField).size() + blob.size();
+  size_t plain_wire = resp_size(plain_args);
+  std::printf("%-5s %6zu B  wire %6zu -> %6zu (%.1fx)  stored %6zu -> %6zu "
+              "(%.1fx)  encode %7.2f us  decode %7.2f us\n",
+              name, response.size(), plain_wire, compact_wire,
+              (double)plain_wire / compact_wire, plain_stored, compact_stored,
+              (double)plain_stored / compact_stored, encode_us, decode_us);
+}
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  std::vector<std::pair<const char *, VLMCompression>> codecs = {
+      {"none", VLMCompression::NONE},
+      {"zstd", VLMCompression::ZSTD},
+      {"lz4", VLMCompression::LZ4},
+  };
+  for (size_t length : {48, 256, 1024, 4096}) {
+    std::string response = make_response(length);
+    for (const auto &[name, compression] : codecs) {
+      if (!VLMResultCodec::available(compression)) {
+        continue;
+      }
+      run(name, VLMResultCodec(compression, 128), response, iterations);
+    }
+  }
+  return 0;
+}
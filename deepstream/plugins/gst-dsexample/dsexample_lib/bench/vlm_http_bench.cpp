@@ -0,0 +1,87 @@
+/*
+ * Request concurrency of VLMHttpClient from a single submitting thread.
+ *
+ * Sends `requests` chat/completions requests, each carrying one synthetic
+ * frame as a BMP data URI, from one thread (as one VLM worker would) with
+ * max_inflight set to 1 and to `inflight`. Reports throughput, latency and
+ * how many TCP connections were opened. Run it against a real backend or
+ * vlm/mock_vlm_server.py, whose GET /stats also shows the peak number of
+ * requests it served concurrently.
+ *
+ * Build and run:
+ *   python3 ../../../../../vlm/mock_vlm_server.py --latency-ms 200 &
+ *   g++ -O2 -std=c++17 -pthread -I.. vlm_http_bench.cpp -lcurl \
+ *       -o vlm_http_bench
+ *   ./vlm_http_bench [requests] [inflight] [url]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "vlm_http_client.h"
+
+static void run(const std::string &url, const std::string &body, int requests,
+    size_t inflight) {
+  VLMHttpClientConfig config;
+  config.url = url;
+  config.max_inflight = inflight;
+  config.request_timeout = std::chrono::milliseconds(60000);
+  VLMHttpClient client(config);
+
+  std::mutex m;
+  std::vector<double> latencies_ms;
+  std::string first_error;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < requests; ++i) {
+    client.submit(body, [&](VLMHttpResult result) {
+      std::lock_guard<std::mutex> lock(m);
+      latencies_ms.push_back(result.latency.count() / 1000.0);
+      if (!result.ok && first_error.empty()) {
+        first_error = result.error;
+      }
+    });
+  }
+  while (client.stats().inflight > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  double s = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  VLMHttpClient::Stats stats = client.stats();
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  printf("%-9zu %10.1f %10.1f %10.1f %9llu %9llu\n", inflight, requests / s,
+      latencies_ms[latencies_ms.size() / 2],
+      latencies_ms[latencies_ms.size() * 99 / 100],
+      (unsigned long long) stats.connects,
+      (unsigned long long) stats.failures);
+  if (!first_error.empty()) {
+    printf("          first error: %s\n", first_error.c_str());
+  }
+}
+
+int main(int argc, char **argv) {
+  int requests = argc > 1 ? std::atoi(argv[1]) : 200;
+  size_t inflight = argc > 2 ? std::atoi(argv[2]) : 32;
+  std::string url = argc > 3 ? argv[3] : "http://127.0.0.1:8000/v1/chat/completions";
+
+  const uint32_t width = 320, height = 240;
+  std::vector<uint8_t> pixels(width * height * 3);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = (uint8_t)(i * 31);
+  }
+  VLMHttpClientConfig config;
+  std::string body = VLMHttpClient(config).build_request(vlm_image_data_uri(
+      "image/bmp", vlm_encode_bmp(pixels.data(), width, height, 3)));
+
+  printf("%d requests, %zu-byte body\n", requests, body.size());
+  printf("%-9s %10s %10s %10s %9s %9s\n", "inflight", "req/s", "p50 ms",
+      "p99 ms", "connects", "failures");
+  run(url, body, std::min(requests, 20), 1);
+  run(url, body, requests, inflight);
+  return 0;
+}
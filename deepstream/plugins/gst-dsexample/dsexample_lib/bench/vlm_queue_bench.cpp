@@ -0,0 +1,156 @@
+/*
+ * Microbenchmark for the VLM frame queues.
+ *
+ * Compares the original ThreadSafeQueue usage in transform_ip (size() +
+ * try_pop() + push(), three lock acquisitions and a make_shared per frame)
+ * against MutexFrameQueue and LockFreeFrameQueue under 1, 4 and 16
+ * producers with one consumer. Before timing anything it checks that a
+ * one-entry MpmcRingBuffer holds exactly one entry.
+ *
+ * Build and run:
+ *   g++ -O2 -std=c++17 -pthread -I.. vlm_queue_bench.cpp -o vlm_queue_bench
+ *   ./vlm_queue_bench [pushes-per-producer] [queue-size]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "threadsafe_queue.h"
+#include "vlm_frame_queue.h"
+
+struct BenchFrame {
+  uint32_t source_id = 0;
+  uint32_t frame_number = 0;
+  uint64_t timestamp = 0;
+};
+
+struct BenchResult {
+  double push_ns;       // mean producer-side cost per push
+  uint64_t consumed;
+};
+
+// Original transform_ip pattern.
+class LegacyQueue {
+ public:
+  explicit LegacyQueue(size_t max_size) : max_size_(max_size) {}
+
+  size_t push_drop_oldest(BenchFrame value) {
+    size_t dropped = 0;
+    if ((size_t) queue_.size() >= max_size_) {
+      BenchFrame old;
+      dropped = queue_.try_pop(old) ? 1 : 0;
+    }
+    queue_.push(std::move(value));
+    return dropped;
+  }
+
+  bool wait_and_pop(BenchFrame &value) {
+    auto data = queue_.wait_and_pop();
+    if (!data) {
+      return false;
+    }
+    value = *data;
+    return true;
+  }
+
+  void terminate() { queue_.terminate(); }
+
+ private:
+  size_t max_size_;
+  ThreadSafeQueue<BenchFrame> queue_;
+};
+
+template <typename Queue>
+static BenchResult run(Queue &queue, int producers, int pushes) {
+  std::atomic<uint64_t> consumed{0};
+  std::atomic<uint64_t> push_ns{0};
+  std::atomic<bool> go{false};
+
+  std::thread consumer([&] {
+    BenchFrame frame;
+    while (queue.wait_and_pop(frame)) {
+      consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < pushes; ++i) {
+        BenchFrame frame;
+        frame.source_id = p;
+        frame.frame_number = i;
+        queue.push_drop_oldest(frame);
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      push_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          elapsed).count();
+    });
+  }
+
+  go = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  // Let the consumer drain before shutting down.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.terminate();
+  consumer.join();
+
+  return {(double) push_ns.load() / ((double) producers * pushes),
+      consumed.load()};
+}
+
+// vlm-queue-size=1 with the lock-free policy: a one-cell ring used to
+// accept a second push over the first and then never pop again
+static bool check_single_entry_ring() {
+  MpmcRingBuffer<int> ring(1);
+  int a = 1, b = 2, out = 0;
+  bool ok = ring.try_push(a) && !ring.try_push(b) && ring.size() == 1 &&
+            ring.try_pop(out) && out == 1 && !ring.try_pop(out);
+  ok = ok && ring.push_evict_oldest(3) == 0 && ring.push_evict_oldest(4) == 1 &&
+       ring.size() == 1 && ring.try_pop(out) && out == 4 && ring.empty();
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  int pushes = argc > 1 ? std::atoi(argv[1]) : 200000;
+  size_t queue_size = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  if (!check_single_entry_ring()) {
+    fprintf(stderr, "one-entry MpmcRingBuffer does not hold exactly one entry\n");
+    return 1;
+  }
+
+  printf("%-10s %-12s %14s %12s\n", "producers", "queue", "ns/push", "consumed");
+  for (int producers : {1, 4, 16}) {
+    {
+      LegacyQueue q(queue_size);
+      auto r = run(q, producers, pushes);
+      printf("%-10d %-12s %14.1f %12llu\n", producers, "legacy",
+          r.push_ns, (unsigned long long) r.consumed);
+    }
+    {
+      MutexFrameQueue<BenchFrame> q(queue_size);
+      auto r = run(q, producers, pushes);
+      printf("%-10d %-12s %14.1f %12llu\n", producers, "fifo",
+          r.push_ns, (unsigned long long) r.consumed);
+    }
+    {
+      LockFreeFrameQueue<BenchFrame> q(queue_size);
+      auto r = run(q, producers, pushes);
+      printf("%-10d %-12s %14.1f %12llu\n", producers, "lockfree",
+          r.push_ns, (unsigned long long) r.consumed);
+    }
+  }
+  return 0;
+}
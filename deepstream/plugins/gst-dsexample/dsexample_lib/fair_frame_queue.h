@@ -0,0 +1,172 @@
+
+#ifndef FAIR_FRAME_QUEUE_H_
+#define FAIR_FRAME_QUEUE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "vlm_frame_queue.h"
+
+// Per-source fair queue. Every source (T::source_id) gets its own FIFO,
+// capped at `max_per_source` entries (its oldest entry is dropped first).
+// Consumers are served by deficit round-robin: each backlogged source may
+// dequeue up to `quantum` entries per turn before the next source is
+// visited, so a bursty camera cannot starve the others. When the total
+// reaches `max_size`, the oldest entry of the longest sub-queue is dropped.
+template <typename T>
+class FairFrameQueue : public VLMFrameQueue<T> {
+ public:
+  FairFrameQueue(size_t max_size, size_t max_per_source, size_t quantum = 1)
+      : max_size_(max_size), max_per_source_(max_per_source),
+        quantum_(quantum < 1 ? 1 : quantum) {}
+
+  size_t push_drop_oldest(T value) override {
+    std::lock_guard<std::mutex> lock(m_);
+    uint32_t id = value.source_id;
+    SourceQueue &source = sources_[id];
+    size_t evicted = 0;
+
+    if (max_per_source_ > 0 && source.items.size() >= max_per_source_) {
+      source.items.pop_front();
+      --total_;
+      ++evicted;
+    } else if (max_size_ > 0 && total_ >= max_size_) {
+      evict_from_longest();
+      ++evicted;
+    }
+
+    source.items.push_back(std::move(value));
+    ++total_;
+    if (!source.active) {
+      source.active = true;
+      source.deficit = 0;
+      active_.push_back(id);
+    }
+    cond_.notify_one();
+    return evicted;
+  }
+
+  bool wait_and_pop(T &value) override {
+    std::unique_lock<std::mutex> lock(m_);
+    cond_.wait(lock, [this] {
+      return total_ > 0 || is_terminated_;
+    });
+    if (is_terminated_) {
+      return false;
+    }
+    pop_locked(value);
+    return true;
+  }
+
+  size_t pop_batch(std::vector<T> &batch, size_t max_items,
+      std::chrono::milliseconds max_wait) override {
+    if (max_items == 0) {
+      return 0;
+    }
+    std::unique_lock<std::mutex> lock(m_);
+    cond_.wait(lock, [this] {
+      return total_ > 0 || is_terminated_;
+    });
+    if (is_terminated_) {
+      return 0;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + max_wait;
+    cond_.wait_until(lock, deadline, [this, max_items] {
+      return total_ >= max_items || is_terminated_;
+    });
+
+    size_t count = 0;
+    T value;
+    while (total_ > 0 && count < max_items) {
+      pop_locked(value);
+      batch.push_back(std::move(value));
+      ++count;
+    }
+    return count;
+  }
+
+  size_t size() const override {
+    std::lock_guard<std::mutex> lock(m_);
+    return total_;
+  }
+
+  size_t source_size(uint32_t source_id) const {
+    std::lock_guard<std::mutex> lock(m_);
+    auto it = sources_.find(source_id);
+    return it == sources_.end() ? 0 : it->second.items.size();
+  }
+
+  void terminate() override {
+    std::lock_guard<std::mutex> lock(m_);
+    is_terminated_ = true;
+    cond_.notify_all();
+  }
+
+ private:
+  struct SourceQueue {
+    std::deque<T> items;
+    size_t deficit = 0;
+    bool active = false;
+  };
+
+  // Caller holds m_ and total_ > 0.
+  void pop_locked(T &value) {
+    uint32_t id = active_.front();
+    SourceQueue &source = sources_[id];
+
+    if (source.deficit == 0) {
+      source.deficit = quantum_;  // start of this source's turn
+    }
+    value = std::move(source.items.front());
+    source.items.pop_front();
+    --total_;
+    --source.deficit;
+
+    if (source.items.empty()) {
+      source.active = false;
+      source.deficit = 0;
+      active_.pop_front();
+    } else if (source.deficit == 0) {
+      active_.pop_front();
+      active_.push_back(id);
+    }
+  }
+
+  // Caller holds m_ and total_ > 0.
+  void evict_from_longest() {
+    auto longest = sources_.end();
+    for (auto it = sources_.begin(); it != sources_.end(); ++it) {
+      if (longest == sources_.end() ||
+          it->second.items.size() > longest->second.items.size()) {
+        longest = it;
+      }
+    }
+    SourceQueue &source = longest->second;
+    source.items.pop_front();
+    --total_;
+    if (source.items.empty() && source.active) {
+      source.active = false;
+      source.deficit = 0;
+      active_.erase(std::find(active_.begin(), active_.end(), longest->first));
+    }
+  }
+
+  const size_t max_size_;
+  const size_t max_per_source_;
+  const size_t quantum_;
+  mutable std::mutex m_{};
+  std::condition_variable cond_{};
+  std::unordered_map<uint32_t, SourceQueue> sources_{};
+  std::deque<uint32_t> active_{};  // round-robin order of backlogged sources
+  size_t total_ = 0;
+  bool is_terminated_ = false;
+};
+
+#endif //FAIR_FRAME_QUEUE_H_
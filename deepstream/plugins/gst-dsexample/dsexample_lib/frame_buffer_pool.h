@@ -0,0 +1,212 @@
+
+#ifndef FRAME_BUFFER_POOL_H_
+#define FRAME_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "mpmc_ring_buffer.h"
+
+// Pixel layout of a pooled frame buffer.
+enum class VLMFrameFormat : uint8_t {
+  UNKNOWN = 0,
+  GRAY8,
+  RGB,
+  RGBA,
+  NV12,
+};
+
+inline const char *vlm_frame_format_name(VLMFrameFormat format) {
+  switch (format) {
+    case VLMFrameFormat::GRAY8: return "GRAY8";
+    case VLMFrameFormat::RGB:   return "RGB";
+    case VLMFrameFormat::RGBA:  return "RGBA";
+    case VLMFrameFormat::NV12:  return "NV12";
+    default:                    return "UNKNOWN";
+  }
+}
+
+inline uint32_t vlm_frame_format_channels(VLMFrameFormat format) {
+  switch (format) {
+    case VLMFrameFormat::GRAY8: return 1;
+    case VLMFrameFormat::RGB:   return 3;
+    case VLMFrameFormat::RGBA:  return 4;
+    default:                    return 0;
+  }
+}
+
+class FrameBufferPool;
+
+namespace frame_buffer_pool_detail {
+
+struct Block {
+  std::atomic<uint32_t> refs{0};
+  struct Core *core = nullptr;  // null for one-off heap blocks (pool misses)
+  uint8_t *data = nullptr;
+  size_t capacity = 0;
+};
+
+// Storage shared by the pool and every outstanding handle, so buffers that
+// are still queued when the element stops stay valid until released.
+struct Core {
+  Core(size_t block_size, size_t block_count)
+      : block_size(block_size), block_count(block_count),
+        free_list(block_count), blocks(new Block[block_count]),
+        storage(new (std::align_val_t(64)) uint8_t[block_size * block_count]) {
+    for (size_t i = 0; i < block_count; ++i) {
+      blocks[i].core = this;
+      blocks[i].data = storage + i * block_size;
+      blocks[i].capacity = block_size;
+      Block *block = &blocks[i];
+      free_list.try_push(block);
+    }
+  }
+
+  ~Core() {
+    delete[] blocks;
+    ::operator delete[](storage, std::align_val_t(64));
+  }
+
+  void unref() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  const size_t block_size;
+  const size_t block_count;
+  MpmcRingBuffer<Block *> free_list;
+  Block *blocks;
+  uint8_t *storage;
+  std::atomic<uint32_t> refs{1};  // the pool + one per outstanding block
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> in_use{0};
+  std::atomic<uint64_t> high_water{0};
+};
+
+}  // namespace frame_buffer_pool_detail
+
+// Refcounted handle to a fixed-size frame buffer. Copying shares the buffer;
+// when the last handle goes away the buffer goes back to its pool.
+class FrameBufferHandle {
+ public:
+  FrameBufferHandle() = default;
+
+  FrameBufferHandle(const FrameBufferHandle &other) : block_(other.block_) {
+    if (block_) {
+      block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  FrameBufferHandle(FrameBufferHandle &&other) noexcept
+      : block_(other.block_) {
+    other.block_ = nullptr;
+  }
+
+  FrameBufferHandle &operator=(FrameBufferHandle other) noexcept {
+    std::swap(block_, other.block_);
+    return *this;
+  }
+
+  ~FrameBufferHandle() {
+    reset();
+  }
+
+  void reset() {
+    if (!block_) {
+      return;
+    }
+    if (block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release(block_);
+    }
+    block_ = nullptr;
+  }
+
+  uint8_t *data() const { return block_ ? block_->data : nullptr; }
+  size_t capacity() const { return block_ ? block_->capacity : 0; }
+  bool pooled() const { return block_ && block_->core; }
+  explicit operator bool() const { return block_ != nullptr; }
+
+ private:
+  friend class FrameBufferPool;
+  using Block = frame_buffer_pool_detail::Block;
+
+  explicit FrameBufferHandle(Block *block) : block_(block) {
+    block_->refs.store(1, std::memory_order_relaxed);
+  }
+
+  static void release(Block *block) {
+    auto *core = block->core;
+    if (!core) {
+      delete[] block->data;
+      delete block;
+      return;
+    }
+    core->in_use.fetch_sub(1, std::memory_order_relaxed);
+    core->free_list.try_push(block);
+    core->unref();
+  }
+
+  Block *block_ = nullptr;
+};
+
+// Fixed number of equally sized buffers allocated once up front. acquire()
+// is lock-free; when the pool is exhausted (or a larger buffer is asked
+// for) it falls back to a heap allocation and counts a miss.
+class FrameBufferPool {
+ public:
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t in_use;
+    uint64_t high_water;
+    size_t block_size;
+    size_t block_count;
+  };
+
+  FrameBufferPool(size_t block_size, size_t block_count)
+      : core_(new frame_buffer_pool_detail::Core(block_size, block_count)) {}
+
+  FrameBufferPool(const FrameBufferPool &) = delete;
+  FrameBufferPool &operator=(const FrameBufferPool &) = delete;
+
+  ~FrameBufferPool() {
+    core_->unref();
+  }
+
+  FrameBufferHandle acquire(size_t size) {
+    frame_buffer_pool_detail::Block *block = nullptr;
+    if (size <= core_->block_size && core_->free_list.try_pop(block)) {
+      core_->refs.fetch_add(1, std::memory_order_relaxed);
+      core_->hits.fetch_add(1, std::memory_order_relaxed);
+      uint64_t in_use =
+          core_->in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+      uint64_t high = core_->high_water.load(std::memory_order_relaxed);
+      while (in_use > high &&
+          !core_->high_water.compare_exchange_weak(high, in_use,
+              std::memory_order_relaxed)) {
+      }
+      return FrameBufferHandle(block);
+    }
+
+    core_->misses.fetch_add(1, std::memory_order_relaxed);
+    block = new frame_buffer_pool_detail::Block();
+    block->data = new uint8_t[size];
+    block->capacity = size;
+    return FrameBufferHandle(block);
+  }
+
+  Stats stats() const {
+    return {core_->hits.load(), core_->misses.load(), core_->in_use.load(),
+        core_->high_water.load(), core_->block_size, core_->block_count};
+  }
+
+ private:
+  frame_buffer_pool_detail::Core *core_;
+};
+
+#endif //FRAME_BUFFER_POOL_H_
@@ -0,0 +1,127 @@
+
+#ifndef LATEST_FRAME_QUEUE_H_
+#define LATEST_FRAME_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "vlm_frame_queue.h"
+
+// Coalescing queue: holds at most one pending entry per source
+// (T::source_id). A newer entry for a source that is still waiting replaces
+// the older one in place, keeping its position in line, so consumers always
+// see the most recent frame of each camera. Sources are served in the order
+// they became pending. `max_size` caps the number of pending sources; past
+// it the source that has been waiting longest is dropped.
+template <typename T>
+class LatestFrameQueue : public VLMFrameQueue<T> {
+ public:
+  explicit LatestFrameQueue(size_t max_size) : max_size_(max_size) {}
+
+  size_t push_drop_oldest(T value) override {
+    T dropped{};  // Released after the lock, e.g. back to a buffer pool
+    std::lock_guard<std::mutex> lock(m_);
+    uint32_t id = value.source_id;
+    Slot &slot = slots_[id];
+    size_t evicted = 0;
+
+    if (slot.pending) {
+      slot.value = std::move(value);  // coalesce: stale entry replaced
+      ++evicted;
+    } else {
+      if (max_size_ > 0 && ready_.size() >= max_size_) {
+        // Its source may never push again, so the slot must not keep it
+        Slot &oldest = slots_[ready_.front()];
+        dropped = std::move(oldest.value);
+        oldest.value = T{};
+        oldest.pending = false;
+        ready_.pop_front();
+        ++evicted;
+      }
+      slot.value = std::move(value);
+      slot.pending = true;
+      ready_.push_back(id);
+    }
+    cond_.notify_one();
+    return evicted;
+  }
+
+  bool wait_and_pop(T &value) override {
+    std::unique_lock<std::mutex> lock(m_);
+    cond_.wait(lock, [this] {
+      return !ready_.empty() || is_terminated_;
+    });
+    if (is_terminated_) {
+      return false;
+    }
+    pop_locked(value);
+    return true;
+  }
+
+  size_t pop_batch(std::vector<T> &batch, size_t max_items,
+      std::chrono::milliseconds max_wait) override {
+    if (max_items == 0) {
+      return 0;
+    }
+    std::unique_lock<std::mutex> lock(m_);
+    cond_.wait(lock, [this] {
+      return !ready_.empty() || is_terminated_;
+    });
+    if (is_terminated_) {
+      return 0;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + max_wait;
+    cond_.wait_until(lock, deadline, [this, max_items] {
+      return ready_.size() >= max_items || is_terminated_;
+    });
+
+    size_t count = 0;
+    T value;
+    while (!ready_.empty() && count < max_items) {
+      pop_locked(value);
+      batch.push_back(std::move(value));
+      ++count;
+    }
+    return count;
+  }
+
+  size_t size() const override {
+    std::lock_guard<std::mutex> lock(m_);
+    return ready_.size();
+  }
+
+  void terminate() override {
+    std::lock_guard<std::mutex> lock(m_);
+    is_terminated_ = true;
+    cond_.notify_all();
+  }
+
+ private:
+  struct Slot {
+    T value{};
+    bool pending = false;
+  };
+
+  // Caller holds m_ and ready_ is not empty.
+  void pop_locked(T &value) {
+    Slot &slot = slots_[ready_.front()];
+    ready_.pop_front();
+    value = std::move(slot.value);
+    slot.pending = false;
+  }
+
+  const size_t max_size_;
+  mutable std::mutex m_{};
+  std::condition_variable cond_{};
+  std::unordered_map<uint32_t, Slot> slots_{};
+  std::deque<uint32_t> ready_{};  // sources with a pending entry, oldest first
+  bool is_terminated_ = false;
+};
+
+#endif //LATEST_FRAME_QUEUE_H_
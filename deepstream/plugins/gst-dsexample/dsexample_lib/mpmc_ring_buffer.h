@@ -0,0 +1,126 @@
+
+#ifndef MPMC_RING_BUFFER_H_
+#define MPMC_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free multi-producer / multi-consumer ring buffer.
+//
+// Every cell carries a sequence number that tells producers and consumers
+// whose turn it is, so a push or pop is a single CAS on the shared position
+// plus one release store on the cell. Items are stored by value in a buffer
+// allocated once at construction; nothing is allocated on push/pop.
+// Capacity does not have to be a power of two.
+//
+// The sequence scheme needs at least two cells: with one, a filled cell's
+// sequence (pos + 1) equals the next producer's position, so the second
+// push would overwrite the first entry. A capacity of 1 therefore gets a
+// two-cell ring and push checks the occupancy against the capacity itself.
+template <typename T>
+class MpmcRingBuffer {
+ public:
+  explicit MpmcRingBuffer(size_t capacity)
+      : capacity_(capacity < 1 ? 1 : capacity),
+        cell_count_(capacity_ < 2 ? 2 : capacity_),
+        cells_(new Cell[cell_count_]) {
+    for (size_t i = 0; i < cell_count_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+  MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+  // Moves from `value` only when the push succeeds.
+  bool try_push(T &value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (capacity_ < cell_count_ &&
+          pos - dequeue_pos_.load(std::memory_order_acquire) >= capacity_) {
+        return false;  // full, before the padding cell is used
+      }
+      Cell &cell = cells_[pos % cell_count_];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed)) {
+          cell.data = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool try_pop(T &value) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos % cell_count_];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed)) {
+          value = std::move(cell.data);
+          cell.sequence.store(pos + cell_count_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // empty
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Push that never fails: while the ring is full the oldest entry is
+  // popped and discarded. Returns the number of entries evicted.
+  size_t push_evict_oldest(T value) {
+    size_t evicted = 0;
+    while (!try_push(value)) {
+      T dropped;
+      if (try_pop(dropped)) {
+        ++evicted;
+      }
+    }
+    return evicted;
+  }
+
+  // Approximate when producers/consumers are active.
+  size_t size() const {
+    size_t enq = enqueue_pos_.load(std::memory_order_relaxed);
+    size_t deq = dequeue_pos_.load(std::memory_order_relaxed);
+    return enq > deq ? enq - deq : 0;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  struct alignas(64) Cell {
+    std::atomic<size_t> sequence{0};
+    T data{};
+  };
+
+  const size_t capacity_;
+  const size_t cell_count_;       // capacity_, but at least 2
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+#endif //MPMC_RING_BUFFER_H_
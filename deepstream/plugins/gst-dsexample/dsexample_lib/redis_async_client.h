@@ -0,0 +1,407 @@
+// RedisAsyncClient.h - Non-blocking Redis Streams client on hiredis async
+#ifndef REDIS_ASYNC_CLIENT_H
+#define REDIS_ASYNC_CLIENT_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <iostream>
+#include <map>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <hiredis/hiredis.h>
+#include <hiredis/async.h>
+
+#include "redis_client.h"
+
+// Asynchronous counterpart of RedisClient.
+//
+// All I/O happens on one event-loop thread that polls the Redis sockets and
+// an eventfd used to wake it for new commands; callers never block on the
+// network. Commands go out over two connections: blocking reads
+// (xreadgroup with block_ms > 0) use their own connection, so a long
+// XREADGROUP BLOCK never holds up XADD/XACK/PUBLISH behind it. Blocking
+// reads are still served in order among themselves.
+//
+// Every command has a future-returning form and a callback form. Callbacks
+// run on the event-loop thread and must not block. If the connection is
+// lost the command fails (empty ID / empty result / false) and the next
+// command reconnects. If the wakeup eventfd cannot be created no loop is
+// started, usable() is false and every command fails at once.
+class RedisAsyncClient {
+public:
+    using XaddCallback = std::function<void(std::string message_id)>;
+    using MessagesCallback = std::function<void(std::vector<StreamMessage> messages)>;
+    using StatusCallback = std::function<void(bool ok)>;
+
+    RedisAsyncClient(const std::string& host = "localhost", int port = 6379, const std::string& password = "")
+        : host_(host), port_(port), password_(password), stop_(false), inflight_(0) {
+        write_conn_.owner = this;
+        write_conn_.name = "write";
+        read_conn_.owner = this;
+        read_conn_.name = "blocking-read";
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake_fd_ < 0) {
+            std::cerr << "Redis async client disabled, eventfd failed: "
+                      << std::strerror(errno) << std::endl;
+            return;
+        }
+        loop_ = std::thread(&RedisAsyncClient::event_loop, this);
+    }
+
+    ~RedisAsyncClient() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        if (loop_.joinable()) {
+            wake();
+            loop_.join();
+        }
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+        }
+    }
+
+    RedisAsyncClient(const RedisAsyncClient&) = delete;
+    RedisAsyncClient& operator=(const RedisAsyncClient&) = delete;
+
+    // XADD stream_key * field value ...
+    void xadd(const std::string& stream_key, const std::map<std::string, std::string>& fields,
+              XaddCallback callback) {
+        std::unique_ptr<Command> cmd(new Command());
+        cmd->arg("XADD").arg(stream_key).arg("*");
+        for (const auto& [key, value] : fields) {
+            cmd->arg(key).arg(value);
+        }
+        cmd->done = [callback = std::move(callback)](redisReply* reply) {
+            std::string message_id;
+            if (reply && reply->type == REDIS_REPLY_STRING) {
+                message_id.assign(reply->str, reply->len);
+            }
+            callback(std::move(message_id));
+        };
+        submit(std::move(cmd));
+    }
+
+    std::future<std::string> xadd(const std::string& stream_key,
+                                  const std::map<std::string, std::string>& fields) {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        auto future = promise->get_future();
+        xadd(stream_key, fields, [promise](std::string message_id) {
+            promise->set_value(std::move(message_id));
+        });
+        return future;
+    }
+
+    // XREADGROUP GROUP group consumer [BLOCK ms] COUNT n STREAMS stream >
+    void xreadgroup(const std::string& group_name, const std::string& consumer_name,
+                    const std::string& stream_key, int count, int block_ms,
+                    MessagesCallback callback) {
+        std::unique_ptr<Command> cmd(new Command());
+        cmd->arg("XREADGROUP").arg("GROUP").arg(group_name).arg(consumer_name);
+        if (block_ms > 0) {
+            cmd->arg("BLOCK").arg(std::to_string(block_ms));
+            cmd->blocking = true;
+        }
+        cmd->arg("COUNT").arg(std::to_string(count)).arg("STREAMS").arg(stream_key).arg(">");
+        cmd->done = [callback = std::move(callback)](redisReply* reply) {
+            callback(RedisClient::parse_xread_reply(reply));
+        };
+        submit(std::move(cmd));
+    }
+
+    std::future<std::vector<StreamMessage>> xreadgroup(const std::string& group_name,
+                                                       const std::string& consumer_name,
+                                                       const std::string& stream_key,
+                                                       int count = 1, int block_ms = 0) {
+        auto promise = std::make_shared<std::promise<std::vector<StreamMessage>>>();
+        auto future = promise->get_future();
+        xreadgroup(group_name, consumer_name, stream_key, count, block_ms,
+                   [promise](std::vector<StreamMessage> messages) {
+                       promise->set_value(std::move(messages));
+                   });
+        return future;
+    }
+
+    // XACK stream group id; ok when at least one entry was acknowledged
+    void xack(const std::string& stream_key, const std::string& group_name,
+              const std::string& message_id, StatusCallback callback) {
+        std::unique_ptr<Command> cmd(new Command());
+        cmd->arg("XACK").arg(stream_key).arg(group_name).arg(message_id);
+        cmd->done = [callback = std::move(callback)](redisReply* reply) {
+            callback(reply && reply->type == REDIS_REPLY_INTEGER && reply->integer > 0);
+        };
+        submit(std::move(cmd));
+    }
+
+    std::future<bool> xack(const std::string& stream_key, const std::string& group_name,
+                           const std::string& message_id) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future = promise->get_future();
+        xack(stream_key, group_name, message_id, [promise](bool ok) {
+            promise->set_value(ok);
+        });
+        return future;
+    }
+
+    void publish(const std::string& channel, const std::string& message, StatusCallback callback) {
+        std::unique_ptr<Command> cmd(new Command());
+        cmd->arg("PUBLISH").arg(channel).arg(message);
+        cmd->done = [callback = std::move(callback)](redisReply* reply) {
+            callback(reply && reply->type == REDIS_REPLY_INTEGER);
+        };
+        submit(std::move(cmd));
+    }
+
+    std::future<bool> publish(const std::string& channel, const std::string& message) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future = promise->get_future();
+        publish(channel, message, [promise](bool ok) {
+            promise->set_value(ok);
+        });
+        return future;
+    }
+
+    // False when construction failed; commands then fail immediately
+    bool usable() const {
+        return wake_fd_ >= 0;
+    }
+
+    // Commands submitted but not yet answered
+    size_t inflight() const {
+        return inflight_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Command {
+        std::string args;               // arguments back to back
+        std::vector<size_t> lens;
+        bool blocking = false;          // goes to the blocking-read connection
+        std::function<void(redisReply*)> done;  // reply is null on failure
+
+        Command& arg(const std::string& value) {
+            args.append(value);
+            lens.push_back(value.size());
+            return *this;
+        }
+    };
+
+    // One async connection plus the I/O interest hiredis asked for.
+    struct Connection {
+        RedisAsyncClient* owner = nullptr;
+        const char* name = "";
+        redisAsyncContext* ctx = nullptr;
+        bool reading = false;
+        bool writing = false;
+    };
+
+    void submit(std::unique_ptr<Command> cmd) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!stop_ && wake_fd_ >= 0) {
+                inflight_.fetch_add(1, std::memory_order_relaxed);
+                submissions_.push_back(std::move(cmd));  // leaves cmd null
+            }
+        }
+        if (cmd) {
+            cmd->done(nullptr);  // shutting down, or no event loop
+            return;
+        }
+        wake();
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t written = write(wake_fd_, &one, sizeof(one));
+        (void)written;  // counter saturation just means a wakeup is pending
+    }
+
+    void event_loop() {
+        std::deque<std::unique_ptr<Command>> ready;
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stop_) break;
+                ready.swap(submissions_);
+            }
+            while (!ready.empty()) {
+                issue(ready.front().release());
+                ready.pop_front();
+            }
+
+            struct pollfd fds[3];
+            Connection* conns[3] = {nullptr, nullptr, nullptr};
+            nfds_t n = 0;
+            fds[n] = {wake_fd_, POLLIN, 0};
+            n++;
+            for (Connection* conn : {&write_conn_, &read_conn_}) {
+                if (!conn->ctx || !(conn->reading || conn->writing)) continue;
+                short events = (conn->reading ? POLLIN : 0) | (conn->writing ? POLLOUT : 0);
+                fds[n] = {conn->ctx->c.fd, events, 0};
+                conns[n] = conn;
+                n++;
+            }
+
+            if (poll(fds, n, -1) < 0) {
+                continue;  // EINTR
+            }
+
+            if (fds[0].revents & POLLIN) {
+                uint64_t count;
+                ssize_t got = read(wake_fd_, &count, sizeof(count));
+                (void)got;
+            }
+            for (nfds_t i = 1; i < n; i++) {
+                Connection* conn = conns[i];
+                if (conn->ctx && (fds[i].revents & (POLLIN | POLLERR | POLLHUP))) {
+                    redisAsyncHandleRead(conn->ctx);
+                }
+                // the read may have dropped the connection (ctx reset by cleanup)
+                if (conn->ctx && (fds[i].revents & POLLOUT)) {
+                    redisAsyncHandleWrite(conn->ctx);
+                }
+            }
+        }
+
+        // Shutdown: freeing the contexts fails their pending callbacks
+        for (Connection* conn : {&write_conn_, &read_conn_}) {
+            if (conn->ctx) {
+                redisAsyncFree(conn->ctx);
+            }
+        }
+        std::deque<std::unique_ptr<Command>> leftover;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            leftover.swap(submissions_);
+        }
+        for (auto& cmd : leftover) {
+            finish(cmd.release(), nullptr);
+        }
+    }
+
+    // Event-loop thread only. Takes ownership of cmd.
+    void issue(Command* cmd) {
+        Connection& conn = cmd->blocking ? read_conn_ : write_conn_;
+        if (!conn.ctx && !connect(conn)) {
+            finish(cmd, nullptr);
+            return;
+        }
+
+        std::vector<const char*> argv;
+        argv.reserve(cmd->lens.size());
+        const char* data = cmd->args.data();
+        for (size_t len : cmd->lens) {
+            argv.push_back(data);
+            data += len;
+        }
+        if (redisAsyncCommandArgv(conn.ctx, &RedisAsyncClient::on_reply, cmd,
+                                  (int)argv.size(), argv.data(), cmd->lens.data()) != REDIS_OK) {
+            finish(cmd, nullptr);
+        }
+    }
+
+    void finish(Command* cmd, redisReply* reply) {
+        try {
+            cmd->done(reply);
+        } catch (const std::exception& e) {
+            std::cerr << "Redis async callback error: " << e.what() << std::endl;
+        }
+        delete cmd;
+        inflight_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Event-loop thread only.
+    bool connect(Connection& conn) {
+        redisAsyncContext* ctx = redisAsyncConnect(host_.c_str(), port_);
+        if (ctx == nullptr || ctx->err) {
+            if (ctx) {
+                std::cerr << "Redis async connection error (" << conn.name << "): "
+                          << ctx->errstr << std::endl;
+                redisAsyncFree(ctx);
+            }
+            return false;
+        }
+
+        conn.ctx = ctx;
+        conn.reading = false;
+        conn.writing = false;
+        ctx->data = &conn;
+        ctx->ev.data = &conn;
+        ctx->ev.addRead = [](void* p) { static_cast<Connection*>(p)->reading = true; };
+        ctx->ev.delRead = [](void* p) { static_cast<Connection*>(p)->reading = false; };
+        ctx->ev.addWrite = [](void* p) { static_cast<Connection*>(p)->writing = true; };
+        ctx->ev.delWrite = [](void* p) { static_cast<Connection*>(p)->writing = false; };
+        ctx->ev.cleanup = [](void* p) {
+            // hiredis is about to free the context
+            Connection* c = static_cast<Connection*>(p);
+            c->ctx = nullptr;
+            c->reading = false;
+            c->writing = false;
+        };
+        redisAsyncSetConnectCallback(ctx, &RedisAsyncClient::on_connect);
+        redisAsyncSetDisconnectCallback(ctx, &RedisAsyncClient::on_disconnect);
+
+        if (!password_.empty()) {
+            std::unique_ptr<Command> auth(new Command());
+            auth->arg("AUTH").arg(password_);
+            auth->done = [](redisReply* reply) {
+                if (!reply || reply->type == REDIS_REPLY_ERROR) {
+                    std::cerr << "Redis async auth error" << std::endl;
+                }
+            };
+            inflight_.fetch_add(1, std::memory_order_relaxed);
+            issue(auth.release());  // queued ahead of the caller's command
+        }
+        return true;
+    }
+
+    static void on_reply(redisAsyncContext* ctx, void* reply, void* privdata) {
+        Connection* conn = static_cast<Connection*>(ctx->data);
+        conn->owner->finish(static_cast<Command*>(privdata), static_cast<redisReply*>(reply));
+    }
+
+    static void on_connect(const redisAsyncContext* ctx, int status) {
+        const Connection* conn = static_cast<const Connection*>(ctx->data);
+        if (status != REDIS_OK) {
+            std::cerr << "Redis async connect failed (" << conn->name << "): "
+                      << (ctx->errstr ? ctx->errstr : "") << std::endl;
+        } else {
+            std::cout << "✅ Redis async connected (" << conn->name << "): "
+                      << conn->owner->host_ << ":" << conn->owner->port_ << std::endl;
+        }
+    }
+
+    static void on_disconnect(const redisAsyncContext* ctx, int status) {
+        const Connection* conn = static_cast<const Connection*>(ctx->data);
+        if (status != REDIS_OK) {
+            std::cerr << "Redis async connection lost (" << conn->name << "): "
+                      << (ctx->errstr ? ctx->errstr : "") << std::endl;
+        }
+    }
+
+    std::string host_;
+    int port_;
+    std::string password_;
+
+    Connection write_conn_;   // event-loop thread only
+    Connection read_conn_;    // event-loop thread only
+
+    std::mutex mutex_;
+    std::deque<std::unique_ptr<Command>> submissions_;
+    bool stop_;
+    std::atomic<size_t> inflight_;
+    int wake_fd_;
+    std::thread loop_;
+};
+
+#endif // REDIS_ASYNC_CLIENT_H
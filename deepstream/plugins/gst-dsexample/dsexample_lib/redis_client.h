@@ -9,14 +9,143 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
 #include <iostream>
 #include <chrono>
 #include <map>
+#include <queue>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <string_view>
+#include <charconv>
+#include <cstdio>
+#include <optional>
+#include <type_traits>
+#include <future>
+#include <condition_variable>
+#include <deque>
+#include <random>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
 #include <hiredis/hiredis.h>
 #include <nlohmann/json.hpp>
 
+#include "redis_spill_log.h"
+#include "vlm_result_codec.h"
+
 using json = nlohmann::json;
 
+// Millisecond part of a stream ID ("<ms>-<seq>"), 0 if malformed
+inline uint64_t stream_id_timestamp(std::string_view id) {
+    uint64_t timestamp = 0;
+    std::from_chars(id.data(), id.data() + id.size(), timestamp);
+    return timestamp;
+}
+
+// Sequence part of a stream ID, 0 if absent
+inline uint64_t stream_id_sequence(std::string_view id) {
+    uint64_t sequence = 0;
+    size_t dash_pos = id.find('-');
+    if (dash_pos != std::string_view::npos) {
+        std::from_chars(id.data() + dash_pos + 1, id.data() + id.size(), sequence);
+    }
+    return sequence;
+}
+
+// Parse a whole field value as an integer or floating-point T. Nullopt if
+// the value is empty, malformed, has trailing bytes or is out of range.
+template<typename T>
+std::optional<T> parse_field_value(std::string_view value) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "numeric field types only");
+    T result;
+    const char* end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, result);
+    if (ec != std::errc() || ptr != end || value.empty()) return std::nullopt;
+    return result;
+}
+
+// Redis Cluster hash slot of `key`: CRC16 (XMODEM) of the key mod 16384.
+// If the key has a non-empty "{...}" section only that part is hashed, so
+// keys sharing a hash tag always land on the same node.
+inline uint16_t redis_key_hash_slot(std::string_view key) {
+    size_t open = key.find('{');
+    if (open != std::string_view::npos) {
+        size_t close = key.find('}', open + 1);
+        if (close != std::string_view::npos && close != open + 1) {
+            key = key.substr(open + 1, close - open - 1);
+        }
+    }
+    uint16_t crc = 0;
+    for (unsigned char c : key) {
+        crc ^= (uint16_t)(c << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc & 16383;
+}
+
+// Trimming applied by XADD or XTRIM. Approximate ("~") trimming lets Redis
+// drop whole radix-tree nodes, which costs far less than exact trimming and
+// keeps the stream at, or slightly above, the threshold.
+struct StreamTrim {
+    enum class Strategy { NONE, MAXLEN, MINID, MAX_AGE };
+
+    Strategy strategy = Strategy::NONE;
+    uint64_t threshold = 0;   // MAXLEN: entries kept, MINID: oldest ms kept, MAX_AGE: age in ms
+    bool approximate = true;
+    uint64_t limit = 0;       // max entries evicted per command (0 = Redis default)
+
+    static StreamTrim max_length(uint64_t entries, bool approximate = true) {
+        return {Strategy::MAXLEN, entries, approximate, 0};
+    }
+    static StreamTrim min_id(uint64_t timestamp_ms, bool approximate = true) {
+        return {Strategy::MINID, timestamp_ms, approximate, 0};
+    }
+    // MINID of now - age, evaluated each time the command is built
+    static StreamTrim max_age(std::chrono::milliseconds age, bool approximate = true) {
+        return {Strategy::MAX_AGE, (uint64_t)age.count(), approximate, 0};
+    }
+
+    explicit operator bool() const { return strategy != Strategy::NONE; }
+
+    // Emits MAXLEN|MINID ~|= threshold [LIMIT n] through emit(data, len).
+    // Numbers are formatted into `scratch`, which must outlive the command.
+    template <typename Emit>
+    void emit_args(Emit&& emit, char (&scratch)[48]) const {
+        if (strategy == Strategy::NONE) return;
+
+        uint64_t value = threshold;
+        if (strategy == Strategy::MAX_AGE) {
+            uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            value = now > threshold ? now - threshold : 0;
+        }
+        if (strategy == Strategy::MAXLEN) {
+            emit("MAXLEN", 6);
+        } else {
+            emit("MINID", 5);
+        }
+        emit(approximate ? "~" : "=", 1);
+        char* end = std::to_chars(scratch, scratch + 24, value).ptr;
+        emit(scratch, (size_t)(end - scratch));
+
+        // LIMIT is only accepted together with "~"
+        if (limit > 0 && approximate) {
+            emit("LIMIT", 5);
+            end = std::to_chars(scratch + 24, scratch + 48, limit).ptr;
+            emit(scratch + 24, (size_t)(end - (scratch + 24)));
+        }
+    }
+};
+
+// One field/value pair of an XADD, viewing the caller's bytes. Values may
+// hold arbitrary binary data (embedded NULs included).
+using StreamFieldView = std::pair<std::string_view, std::string_view>;
+
 // Redis Stream message structure
 struct StreamMessage {
     std::string id;           // Redis stream ID (e.g., "1672531200000-0")
@@ -28,12 +157,7 @@ struct StreamMessage {
     StreamMessage(const std::string& stream_id, const std::map<std::string, std::string>& data) 
         : id(stream_id), fields(data) {
         // Parse timestamp from stream ID (format: timestamp-sequence)
-        size_t dash_pos = stream_id.find('-');
-        if (dash_pos != std::string::npos) {
-            timestamp = std::stoull(stream_id.substr(0, dash_pos));
-        } else {
-            timestamp = 0;
-        }
+        timestamp = stream_id.find('-') != std::string::npos ? stream_id_timestamp(stream_id) : 0;
     }
     
     // Helper to get field as string
@@ -42,21 +166,482 @@ struct StreamMessage {
         return (it != fields.end()) ? it->second : default_value;
     }
     
-    // Helper to get field as number
+    // Helper to get field as number; `default_value` if the field is
+    // missing or not a number
     template<typename T>
     T get_field_as(const std::string& key, T default_value = T{}) const {
+        return try_field_as<T>(key).value_or(default_value);
+    }
+    
+    // Field as number, nullopt if missing or malformed (see parse_field_value)
+    template<typename T>
+    std::optional<T> try_field_as(const std::string& key) const {
         auto it = fields.find(key);
-        if (it != fields.end()) {
-            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, uint32_t>) {
-                return static_cast<T>(std::stoi(it->second));
-            } else if constexpr (std::is_same_v<T, uint64_t>) {
-                return std::stoull(it->second);
-            } else if constexpr (std::is_same_v<T, double>) {
-                return std::stod(it->second);
+        if (it == fields.end()) return std::nullopt;
+        return parse_field_value<T>(it->second);
+    }
+    
+    // Written with the compact encoding (a single VLMResultCodec::kField)
+    bool is_compact() const {
+        return fields.count(VLMResultCodec::kField) != 0;
+    }
+    
+    // Expand a compact entry in place into the fields of the plain
+    // encoding (frame_number, source_id, vlm_response, model_name,
+    // timestamp from the ID, type). Model names are looked up in `models`
+    // by id; unknown ones become "#<id>". False, leaving the entry as it
+    // was, if it is not compact or cannot be decoded.
+    bool decode_compact(const std::unordered_map<uint32_t, std::string>& models = {}) {
+        auto it = fields.find(VLMResultCodec::kField);
+        if (it == fields.end()) return false;
+        VLMResultRecord record;
+        if (!VLMResultCodec::decode(it->second, record)) return false;
+        
+        auto model = models.find(record.model_id);
+        fields.erase(it);
+        fields["frame_number"] = std::to_string(record.frame_number);
+        fields["source_id"] = std::to_string(record.source_id);
+        fields["vlm_response"] = std::move(record.vlm_response);
+        fields["model_name"] = model != models.end() ? model->second : "#" + std::to_string(record.model_id);
+        fields["timestamp"] = std::to_string(timestamp);
+        fields["type"] = "vlm_result";
+        return true;
+    }
+};
+
+// Read-only view of one stream entry inside a StreamReply. The ID and
+// fields point into the redisReply and stay valid as long as any copy of
+// the StreamReply they came from is alive.
+struct StreamMessageView {
+    using Field = std::pair<std::string_view, std::string_view>;
+
+    std::string_view id;
+    uint64_t timestamp = 0;   // ms part of the ID
+    uint64_t sequence = 0;    // seq part of the ID
+    const Field* fields = nullptr;
+    size_t field_count = 0;
+
+    const Field* begin() const { return fields; }
+    const Field* end() const { return fields + field_count; }
+
+    // Linear scan; entries have a handful of fields
+    std::string_view get_field(std::string_view key, std::string_view default_value = {}) const {
+        const Field* field = find(key);
+        return field ? field->second : default_value;
+    }
+
+    const Field* find(std::string_view key) const {
+        for (const Field& field : *this) {
+            if (field.first == key) return &field;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    T get_field_as(std::string_view key, T default_value = T{}) const {
+        return try_field_as<T>(key).value_or(default_value);
+    }
+
+    template<typename T>
+    std::optional<T> try_field_as(std::string_view key) const {
+        const Field* field = find(key);
+        if (!field) return std::nullopt;
+        return parse_field_value<T>(field->second);
+    }
+
+    // Owning copy, for callers that need to keep the entry
+    StreamMessage to_message() const {
+        StreamMessage message;
+        message.id.assign(id.data(), id.size());
+        message.timestamp = timestamp;
+        for (const Field& field : *this) {
+            message.fields.emplace(std::string(field.first), std::string(field.second));
+        }
+        return message;
+    }
+};
+
+// Stream ID order (ms, then sequence)
+inline bool stream_id_less(const StreamMessageView& a, const StreamMessageView& b) {
+    return a.timestamp != b.timestamp ? a.timestamp < b.timestamp : a.sequence < b.sequence;
+}
+
+// Shared ownership of a reply, freed with freeReplyObject
+inline std::shared_ptr<redisReply> owned_reply(redisReply* reply) {
+    return std::shared_ptr<redisReply>(reply, [](redisReply* r) {
+        if (r) freeReplyObject(r);
+    });
+}
+
+// Parsed XRANGE/XREAD/XREADGROUP reply that keeps the redisReply alive and
+// indexes it in place: one flat vector of field views and one of entries,
+// both sized up front. Parsing does no per-entry or per-field allocation.
+// Copies are cheap and share the same reply.
+class StreamReply {
+public:
+    StreamReply() = default;
+
+    // Takes ownership of `reply` (freed with freeReplyObject)
+    static StreamReply from_xrange(redisReply* reply) {
+        return from_xrange(owned_reply(reply));
+    }
+    static StreamReply from_xread(redisReply* reply) {
+        return from_xread(owned_reply(reply));
+    }
+
+    // XRANGE/XREVRANGE: [[id, [field, value, ...]], ...]
+    static StreamReply from_xrange(std::shared_ptr<redisReply> reply) {
+        StreamReply result;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) return result;
+        auto data = std::make_shared<Data>();
+        data->reply = std::move(reply);
+        data->index({data->reply.get()});
+        result.data_ = std::move(data);
+        return result;
+    }
+
+    // XREAD/XREADGROUP: [[stream, [[id, [field, value, ...]], ...]], ...]
+    static StreamReply from_xread(std::shared_ptr<redisReply> reply) {
+        StreamReply result;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) return result;
+        std::vector<redisReply*> entry_lists;
+        for (size_t i = 0; i < reply->elements; i++) {
+            redisReply* stream_reply = reply->element[i];
+            if (stream_reply->type == REDIS_REPLY_ARRAY && stream_reply->elements >= 2 &&
+                stream_reply->element[1]->type == REDIS_REPLY_ARRAY) {
+                entry_lists.push_back(stream_reply->element[1]);
+            }
+        }
+        auto data = std::make_shared<Data>();
+        data->reply = std::move(reply);
+        data->index(entry_lists);
+        result.data_ = std::move(data);
+        return result;
+    }
+
+    const StreamMessageView* begin() const { return data_ ? data_->messages.data() : nullptr; }
+    const StreamMessageView* end() const { return begin() + size(); }
+    size_t size() const { return data_ ? data_->messages.size() : 0; }
+    bool empty() const { return size() == 0; }
+    const StreamMessageView& operator[](size_t i) const { return data_->messages[i]; }
+
+private:
+    struct Data {
+        std::shared_ptr<redisReply> reply;
+        std::vector<StreamMessageView::Field> fields;
+        std::vector<StreamMessageView> messages;
+
+        // Two passes: count, then fill vectors that never reallocate, so
+        // the views' field pointers stay valid.
+        void index(const std::vector<redisReply*>& entry_lists) {
+            size_t entry_count = 0, field_count = 0;
+            for (redisReply* entries : entry_lists) {
+                for (size_t i = 0; i < entries->elements; i++) {
+                    redisReply* entry = entries->element[i];
+                    if (!valid_entry(entry)) continue;
+                    entry_count++;
+                    field_count += entry->element[1]->elements / 2;
+                }
             }
+            messages.reserve(entry_count);
+            fields.reserve(field_count);
+
+            for (redisReply* entries : entry_lists) {
+                for (size_t i = 0; i < entries->elements; i++) {
+                    redisReply* entry = entries->element[i];
+                    if (!valid_entry(entry)) continue;
+
+                    StreamMessageView view;
+                    view.id = std::string_view(entry->element[0]->str, entry->element[0]->len);
+                    view.timestamp = stream_id_timestamp(view.id);
+                    view.sequence = stream_id_sequence(view.id);
+                    view.fields = fields.data() + fields.size();
+
+                    redisReply* kv = entry->element[1];
+                    for (size_t j = 0; j + 1 < kv->elements; j += 2) {
+                        fields.emplace_back(std::string_view(kv->element[j]->str, kv->element[j]->len),
+                                            std::string_view(kv->element[j + 1]->str, kv->element[j + 1]->len));
+                    }
+                    view.field_count = kv->elements / 2;
+                    messages.push_back(view);
+                }
+            }
+        }
+
+        static bool valid_entry(redisReply* entry) {
+            return entry && entry->type == REDIS_REPLY_ARRAY && entry->elements >= 2 &&
+                   entry->element[0]->type == REDIS_REPLY_STRING &&
+                   entry->element[1]->type == REDIS_REPLY_ARRAY;
+        }
+    };
+
+    std::shared_ptr<const Data> data_;
+};
+
+// Named columns read from many entries of a StreamReply, e.g. for scans
+// over long XRANGE histories. Entries from one producer share a field
+// order, so a column's position is found once (from the first entry read)
+// and afterwards only confirmed with one key comparison per entry; an
+// entry laid out differently falls back to a scan and re-learns the
+// position. Compact entries (VLMResultCodec) answer frame_number,
+// source_id and timestamp from their header without decompressing.
+// Positions are cached in the schema: use one per reading thread.
+class StreamSchema {
+public:
+    static constexpr size_t npos = (size_t)-1;
+
+    StreamSchema(std::initializer_list<std::string_view> columns) {
+        for (std::string_view name : columns) add_column(name);
+    }
+    explicit StreamSchema(const std::vector<std::string>& columns) {
+        for (const std::string& name : columns) add_column(name);
+    }
+
+    size_t size() const { return columns_.size(); }
+    const std::string& name(size_t column) const { return columns_[column].name; }
+
+    // Index of the column called `name`, npos if there is none
+    size_t column(std::string_view name) const {
+        for (size_t i = 0; i < columns_.size(); i++) {
+            if (columns_[i].name == name) return i;
+        }
+        return npos;
+    }
+
+    // Raw value of `column` in `entry`, nullopt if the entry lacks it.
+    // Compact entries have no raw numeric fields; use get_as for those.
+    std::optional<std::string_view> get(const StreamMessageView& entry, size_t column) const {
+        const StreamMessageView::Field* field = locate(entry, columns_[column]);
+        if (!field) return std::nullopt;
+        return field->second;
+    }
+
+    // `column` of `entry` parsed as T, nullopt if missing or malformed
+    template<typename T>
+    std::optional<T> get_as(const StreamMessageView& entry, size_t column) const {
+        const Column& col = columns_[column];
+        if (const StreamMessageView::Field* field = locate(entry, col)) {
+            return parse_field_value<T>(field->second);
+        }
+        if (col.compact == CompactField::NONE) return std::nullopt;
+        std::optional<uint64_t> value = compact_value(entry, col.compact);
+        if (!value) return std::nullopt;
+        return (T)*value;
+    }
+
+    // Columnar read: `column` of every entry of `reply`, in reply order,
+    // into `out` (cleared first). Entries where it is missing or malformed
+    // hold `missing`. Returns how many values parsed.
+    template<typename T>
+    size_t extract(const StreamReply& reply, size_t column, std::vector<T>& out, T missing = T{}) const {
+        out.resize(reply.size());
+        size_t parsed = 0;
+        T* dst = out.data();
+        for (const StreamMessageView& entry : reply) {
+            std::optional<T> value = get_as<T>(entry, column);
+            parsed += value.has_value();
+            *dst++ = value.value_or(missing);
+        }
+        return parsed;
+    }
+
+    template<typename T>
+    std::vector<T> extract(const StreamReply& reply, size_t column, T missing = T{}) const {
+        std::vector<T> out;
+        extract(reply, column, out, missing);
+        return out;
+    }
+
+private:
+    enum class CompactField { NONE, FRAME_NUMBER, SOURCE_ID, TIMESTAMP };
+
+    struct Column {
+        std::string name;
+        CompactField compact;
+        mutable size_t position;   // field index seen last, npos before the first lookup
+    };
+
+    void add_column(std::string_view name) {
+        CompactField compact = name == "frame_number" ? CompactField::FRAME_NUMBER
+                             : name == "source_id"    ? CompactField::SOURCE_ID
+                             : name == "timestamp"    ? CompactField::TIMESTAMP
+                                                      : CompactField::NONE;
+        columns_.push_back({std::string(name), compact, npos});
+    }
+
+    // Numeric header field of a compact entry; kept out of line so the
+    // plain-field path stays small
+    static std::optional<uint64_t> compact_value(const StreamMessageView& entry, CompactField which) {
+        const StreamMessageView::Field* blob = entry.find(VLMResultCodec::kField);
+        if (!blob) return std::nullopt;
+        if (which == CompactField::TIMESTAMP) return entry.timestamp;
+
+        VLMResultRecord record;
+        if (!VLMResultCodec::decode(blob->second, record, false)) return std::nullopt;
+        return which == CompactField::FRAME_NUMBER ? record.frame_number : record.source_id;
+    }
+
+    static const StreamMessageView::Field* locate(const StreamMessageView& entry, const Column& col) {
+        if (col.position < entry.field_count && entry.fields[col.position].first == col.name) {
+            return &entry.fields[col.position];
+        }
+        const StreamMessageView::Field* field = entry.find(col.name);
+        if (field) col.position = (size_t)(field - entry.fields);
+        return field;
+    }
+
+    std::vector<Column> columns_;
+};
+
+// Command arguments packed into one buffer for argv-style calls
+class RedisCommandArgs {
+public:
+    RedisCommandArgs& add(std::string_view arg) {
+        data_.append(arg.data(), arg.size());
+        lens_.push_back(arg.size());
+        return *this;
+    }
+    RedisCommandArgs& add(long long value) {
+        char buf[24];
+        char* end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+        return add(std::string_view(buf, (size_t)(end - buf)));
+    }
+    RedisCommandArgs& add(const StreamTrim& trim) {
+        char scratch[48];
+        trim.emit_args([this](const char* data, size_t len) {
+            add(std::string_view(data, len));
+        }, scratch);
+        return *this;
+    }
+
+    size_t size() const { return lens_.size(); }
+    const size_t* lens() const { return lens_.data(); }
+
+    // Argument pointers into the buffer; valid until the next add()
+    const char** argv() {
+        argv_.clear();
+        const char* data = data_.data();
+        for (size_t len : lens_) {
+            argv_.push_back(data);
+            data += len;
+        }
+        return argv_.data();
+    }
+
+private:
+    std::string data_;
+    std::vector<size_t> lens_;
+    std::vector<const char*> argv_;
+};
+
+// How connections are made. With `unix_socket` set, host and port are
+// ignored and the TCP settings do not apply. Needs hiredis 1.1+.
+struct RedisConnectionOptions {
+    std::string unix_socket;                            // e.g. /var/run/redis/redis.sock
+    std::chrono::milliseconds connect_timeout{1000};
+    std::chrono::milliseconds command_timeout{0};       // per reply, 0 = wait indefinitely
+    std::chrono::seconds keepalive{15};                 // TCP keepalive interval, 0 = off
+    bool tcp_nodelay = true;                            // hiredis' default
+
+    // Null only if hiredis could not allocate a context; otherwise check err
+    redisContext* connect(const std::string& host, int port) const {
+        redisOptions options = {};
+        if (unix_socket.empty()) {
+            REDIS_OPTIONS_SET_TCP(&options, host.c_str(), port);
+        } else {
+            REDIS_OPTIONS_SET_UNIX(&options, unix_socket.c_str());
+        }
+        struct timeval connect_tv = to_timeval(connect_timeout);
+        struct timeval command_tv = to_timeval(command_timeout);
+        if (connect_timeout.count() > 0) options.connect_timeout = &connect_tv;
+        if (command_timeout.count() > 0) options.command_timeout = &command_tv;
+        
+        redisContext* context = redisConnectWithOptions(&options);
+        if (context == nullptr || context->err || !unix_socket.empty()) return context;
+        if (keepalive.count() > 0) {
+            redisEnableKeepAliveWithInterval(context, (int)keepalive.count());
+        }
+        if (!tcp_nodelay) {
+            int off = 0;
+            setsockopt(context->fd, IPPROTO_TCP, TCP_NODELAY, &off, sizeof(off));
         }
-        return default_value;
+        return context;
     }
+    
+    // "host:port" or "unix:<path>", for logs
+    std::string describe(const std::string& host, int port) const {
+        return unix_socket.empty() ? host + ":" + std::to_string(port) : "unix:" + unix_socket;
+    }
+    
+    static struct timeval to_timeval(std::chrono::milliseconds ms) {
+        struct timeval tv;
+        tv.tv_sec = ms.count() / 1000;
+        tv.tv_usec = (ms.count() % 1000) * 1000;
+        return tv;
+    }
+};
+
+// Exponential backoff between reconnect attempts. After a failed connect
+// further attempts are refused until the delay has passed, so callers fail
+// fast instead of each waiting out a TCP connect timeout. The delay doubles
+// per consecutive failure up to `max`, with up to 50% jitter so that many
+// connections do not retry in lockstep, and resets on success. Not
+// thread-safe; used under the owner's lock.
+class ReconnectBackoff {
+public:
+    explicit ReconnectBackoff(std::chrono::milliseconds initial = std::chrono::milliseconds(100),
+                              std::chrono::milliseconds max = std::chrono::milliseconds(30000))
+        : initial_(initial), max_(max), delay_(0), failures_(0),
+          rng_((uint32_t)std::chrono::steady_clock::now().time_since_epoch().count()) {}
+
+    // True if a connect may be attempted now
+    bool ready() const {
+        return failures_ == 0 || std::chrono::steady_clock::now() >= next_attempt_;
+    }
+
+    void failed() {
+        delay_ = failures_++ == 0 ? initial_ : std::min(delay_ * 2, max_);
+        std::uniform_int_distribution<long long> jitter(0, delay_.count() / 2);
+        next_attempt_ = std::chrono::steady_clock::now() + delay_ - std::chrono::milliseconds(jitter(rng_));
+    }
+
+    void succeeded() {
+        failures_ = 0;
+        delay_ = std::chrono::milliseconds(0);
+    }
+
+    uint32_t failures() const { return failures_; }
+
+private:
+    std::chrono::milliseconds initial_;
+    std::chrono::milliseconds max_;
+    std::chrono::milliseconds delay_;
+    uint32_t failures_;
+    std::chrono::steady_clock::time_point next_attempt_;
+    std::minstd_rand rng_;
+};
+
+// XPENDING summary of one consumer group
+struct PendingSummary {
+    uint64_t count = 0;                          // entries delivered but not acknowledged
+    std::string min_id;                          // oldest pending ID ("" if none)
+    std::string max_id;
+    std::map<std::string, uint64_t> consumers;   // consumer -> pending entries
+};
+
+// One entry of XPENDING's extended form
+struct PendingEntry {
+    std::string id;
+    std::string consumer;
+    uint64_t idle_ms = 0;       // since last delivery
+    uint64_t deliveries = 0;    // times delivered
+};
+
+// XAUTOCLAIM result
+struct AutoClaimResult {
+    std::string next_id = "0-0";            // cursor for the next call, "0-0" when done
+    std::vector<StreamMessage> messages;    // entries now owned by the claiming consumer
+    std::vector<std::string> deleted_ids;   // pending IDs whose entry no longer exists
 };
 
 class RedisClient {
@@ -68,36 +653,53 @@ public:
         disconnect();
     }
 
-    // Connection management (same as before)
+    // Connection state as seen by the next command
+    enum class ConnectionState {
+        CONNECTED,
+        DISCONNECTED,   // next command attempts to connect
+        BACKOFF         // connect failed recently; commands fail fast
+    };
+    
+    // Connection management. While backing off after a failed attempt this
+    // returns false without touching the network.
     bool connect() {
         std::lock_guard<std::mutex> lock(mutex_);
         
         if (connected_) return true;
+        if (!backoff_.ready()) return false;
         
-        context_ = redisConnect(host_.c_str(), port_);
+        context_ = options_.connect(host_, port_);
         if (context_ == nullptr || context_->err) {
             if (context_) {
-                std::cerr << "Redis connection error: " << context_->errstr << std::endl;
+                if (backoff_.failures() == 0) {
+                    std::cerr << "Redis connection error: " << context_->errstr << std::endl;
+                }
                 redisFree(context_);
                 context_ = nullptr;
             }
+            backoff_.failed();
             return false;
         }
         
         if (!password_.empty()) {
-            redisReply* reply = (redisReply*)redisCommand(context_, "AUTH %s", password_.c_str());
-            if (reply->type == REDIS_REPLY_ERROR) {
-                std::cerr << "Redis auth error: " << reply->str << std::endl;
-                freeReplyObject(reply);
+            redisReply* reply = command_locked({"AUTH", password_});
+            if (!reply || reply->type == REDIS_REPLY_ERROR) {
+                std::cerr << "Redis auth error: " << (reply ? reply->str : context_->errstr) << std::endl;
+                if (reply) freeReplyObject(reply);
                 redisFree(context_);
                 context_ = nullptr;
+                backoff_.failed();
                 return false;
             }
             freeReplyObject(reply);
         }
         
+        if (backoff_.failures() > 0) {
+            std::cout << "✅ Redis reconnected after " << backoff_.failures() << " failed attempts" << std::endl;
+        }
+        backoff_.succeeded();
         connected_ = true;
-        std::cout << "✅ Redis connected with Streams support: " << host_ << ":" << port_ << std::endl;
+        std::cout << "✅ Redis connected with Streams support: " << options_.describe(host_, port_) << std::endl;
         return true;
     }
     
@@ -114,104 +716,198 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         return connected_ && context_ != nullptr;
     }
-
-    // ✅ NEW: Redis Streams operations
     
-    // Add message to stream with auto-generated ID
-    std::string xadd(const std::string& stream_key, const std::map<std::string, std::string>& fields) {
-        if (!ensure_connected()) return "";
+    ConnectionState connection_state() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connected_ && context_ != nullptr && context_->err == 0) return ConnectionState::CONNECTED;
+        return backoff_.ready() ? ConnectionState::DISCONNECTED : ConnectionState::BACKOFF;
+    }
+    
+    // Bound on each connect attempt and the reconnect backoff range
+    void set_reconnect_policy(std::chrono::milliseconds connect_timeout,
+                              std::chrono::milliseconds initial_backoff,
+                              std::chrono::milliseconds max_backoff) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_.connect_timeout = connect_timeout;
+        backoff_ = ReconnectBackoff(initial_backoff, max_backoff);
+    }
+    
+    // Transport, timeouts and socket options; used from the next connect
+    void set_connection_options(const RedisConnectionOptions& options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+    }
+    
+    // Connected and no I/O or protocol error on the socket so far
+    bool healthy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return connected_ && context_ != nullptr && context_->err == 0;
+    }
+    
+    bool ping() {
+        if (!ensure_connected()) return false;
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        // Build XADD command: XADD stream_key * field1 value1 field2 value2 ...
-        std::vector<const char*> argv;
-        std::vector<std::string> args;
+        redisReply* reply = command_locked({"PING"});
+        bool success = (reply != nullptr && reply->type == REDIS_REPLY_STATUS);
+        if (reply) freeReplyObject(reply);
         
-        args.push_back("XADD");
-        args.push_back(stream_key);
-        args.push_back("*");  // Auto-generate ID
+        return success;
+    }
+    
+    // Any command, returning the reply itself (errors included) or null on
+    // connection failure. With `asking` the command is preceded by ASKING
+    // on the same connection, as required after a cluster ASK redirect.
+    std::shared_ptr<redisReply> command_argv(size_t argc, const char** argv, const size_t* argvlen,
+                                             bool asking = false) {
+        if (!ensure_connected()) return nullptr;
         
-        for (const auto& [key, value] : fields) {
-            args.push_back(key);
-            args.push_back(value);
-        }
+        std::lock_guard<std::mutex> lock(mutex_);
         
-        // Convert to argv format
-        for (const auto& arg : args) {
-            argv.push_back(arg.c_str());
+        if (asking) {
+            redisReply* reply = command_locked({"ASKING"});
+            if (!reply) return nullptr;
+            freeReplyObject(reply);
         }
+        return owned_reply((redisReply*)redisCommandArgv(context_, (int)argc, argv, argvlen));
+    }
+
+    // Send `count` commands in one round trip and read their replies in
+    // order. Command i has argc[i] arguments; the arguments of all commands
+    // are back to back in argv/argvlen. Returns how many replies arrived
+    // (error replies included); fewer than `count` means the connection
+    // failed and the remaining commands may or may not have been applied.
+    size_t pipeline_argv(size_t count, const size_t* argc, const char** argv, const size_t* argvlen) {
+        return pipeline_argv(count, argc, argv, argvlen, [](size_t, redisReply*) {});
+    }
+    
+    // Same, handing reply i to on_reply(i, reply) before it is freed
+    template <typename OnReply>
+    size_t pipeline_argv(size_t count, const size_t* argc, const char** argv, const size_t* argvlen,
+                         OnReply&& on_reply) {
+        if (!ensure_connected()) return 0;
         
-        redisReply* reply = (redisReply*)redisCommandArgv(context_, argv.size(), argv.data(), nullptr);
+        std::lock_guard<std::mutex> lock(mutex_);
         
-        std::string message_id;
-        if (reply && reply->type == REDIS_REPLY_STRING) {
-            message_id = std::string(reply->str, reply->len);
+        for (size_t i = 0; i < count; i++) {
+            redisAppendCommandArgv(context_, (int)argc[i], argv, argvlen);
+            argv += argc[i];
+            argvlen += argc[i];
         }
-        
-        if (reply) freeReplyObject(reply);
-        return message_id;
+        size_t replies = 0;
+        for (; replies < count; replies++) {
+            redisReply* reply = nullptr;
+            if (redisGetReply(context_, (void**)&reply) != REDIS_OK) break;
+            on_reply(replies, reply);
+            if (reply) freeReplyObject(reply);
+        }
+        return replies;
+    }
+
+    // ✅ NEW: Redis Streams operations
+    
+    // Add message to stream with auto-generated ID, optionally trimming it
+    std::string xadd(std::string_view stream_key, const std::map<std::string, std::string>& fields,
+                     const StreamTrim& trim = StreamTrim()) {
+        return xadd_fields(stream_key, fields.begin(), fields.end(), trim);
+    }
+    
+    // Same, with fields viewed rather than owned: nothing is copied
+    // before the bytes reach the socket buffer
+    std::string xadd(std::string_view stream_key, const StreamFieldView* fields, size_t count,
+                     const StreamTrim& trim = StreamTrim()) {
+        return xadd_fields(stream_key, fields, fields + count, trim);
+    }
+    
+    template <size_t N>
+    std::string xadd(std::string_view stream_key, const StreamFieldView (&fields)[N],
+                     const StreamTrim& trim = StreamTrim()) {
+        return xadd_fields(stream_key, fields, fields + N, trim);
     }
     
     // Read messages from stream
-    std::vector<StreamMessage> xread(const std::string& stream_key, const std::string& start_id = "0", 
+    std::vector<StreamMessage> xread(std::string_view stream_key, std::string_view start_id = "0", 
                                    int count = 10, int block_ms = 0) {
         if (!ensure_connected()) return {};
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply;
-        if (block_ms > 0) {
-            // Blocking read: XREAD BLOCK timeout COUNT count STREAMS stream_key start_id
-            reply = (redisReply*)redisCommand(context_, "XREAD BLOCK %d COUNT %d STREAMS %s %s",
-                                            block_ms, count, stream_key.c_str(), start_id.c_str());
-        } else {
-            // Non-blocking read: XREAD COUNT count STREAMS stream_key start_id
-            reply = (redisReply*)redisCommand(context_, "XREAD COUNT %d STREAMS %s %s",
-                                            count, stream_key.c_str(), start_id.c_str());
-        }
-        
+        redisReply* reply = xread_command(stream_key, start_id, count, block_ms);
         std::vector<StreamMessage> messages = parse_xread_reply(reply);
         if (reply) freeReplyObject(reply);
         
         return messages;
     }
     
+    // Same as xread(), returning views into the reply instead of copies
+    StreamReply xread_view(std::string_view stream_key, std::string_view start_id = "0",
+                           int count = 10, int block_ms = 0) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        return StreamReply::from_xread(xread_command(stream_key, start_id, count, block_ms));
+    }
+    
     // Read messages in time range
-    std::vector<StreamMessage> xrange(const std::string& stream_key, const std::string& start = "-", 
-                                    const std::string& end = "+", int count = -1) {
+    std::vector<StreamMessage> xrange(std::string_view stream_key, std::string_view start = "-", 
+                                    std::string_view end = "+", int count = -1) {
         if (!ensure_connected()) return {};
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply;
-        if (count > 0) {
-            reply = (redisReply*)redisCommand(context_, "XRANGE %s %s %s COUNT %d",
-                                            stream_key.c_str(), start.c_str(), end.c_str(), count);
-        } else {
-            reply = (redisReply*)redisCommand(context_, "XRANGE %s %s %s",
-                                            stream_key.c_str(), start.c_str(), end.c_str());
-        }
+        redisReply* reply = xrange_command(stream_key, start, end, count);
+        std::vector<StreamMessage> messages = parse_xrange_reply(reply);
+        if (reply) freeReplyObject(reply);
+        
+        return messages;
+    }
+    
+    // Newest entries first: XREVRANGE stream_key end start [COUNT count]
+    std::vector<StreamMessage> xrevrange(std::string_view stream_key, std::string_view end = "+",
+                                       std::string_view start = "-", int count = -1) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
         
+        redisReply* reply = xrevrange_command(stream_key, end, start, count);
         std::vector<StreamMessage> messages = parse_xrange_reply(reply);
         if (reply) freeReplyObject(reply);
         
         return messages;
     }
     
+    StreamReply xrevrange_view(std::string_view stream_key, std::string_view end = "+",
+                               std::string_view start = "-", int count = -1) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        return StreamReply::from_xrange(xrevrange_command(stream_key, end, start, count));
+    }
+    
+    // Same as xrange(), returning views into the reply instead of copies.
+    // Preferred for large history windows.
+    StreamReply xrange_view(std::string_view stream_key, std::string_view start = "-",
+                            std::string_view end = "+", int count = -1) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        return StreamReply::from_xrange(xrange_command(stream_key, start, end, count));
+    }
+    
     // Create consumer group
-    bool xgroup_create(const std::string& stream_key, const std::string& group_name, 
-                      const std::string& start_id = "$") {
+    bool xgroup_create(std::string_view stream_key, std::string_view group_name, 
+                      std::string_view start_id = "$") {
         if (!ensure_connected()) return false;
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply = (redisReply*)redisCommand(context_, "XGROUP CREATE %s %s %s MKSTREAM",
-                                                    stream_key.c_str(), group_name.c_str(), start_id.c_str());
+        redisReply* reply = command_locked({"XGROUP", "CREATE", stream_key, group_name, start_id, "MKSTREAM"});
         
         bool success = (reply && (reply->type == REDIS_REPLY_STATUS || reply->type == REDIS_REPLY_ERROR));
         if (reply && reply->type == REDIS_REPLY_ERROR) {
-            std::string error(reply->str);
-            success = (error.find("BUSYGROUP") != std::string::npos);  // Group already exists
+            std::string_view error(reply->str, reply->len);
+            success = (error.find("BUSYGROUP") != std::string_view::npos);  // Group already exists
         }
         
         if (reply) freeReplyObject(reply);
@@ -219,35 +915,35 @@ public:
     }
     
     // Read from consumer group
-    std::vector<StreamMessage> xreadgroup(const std::string& group_name, const std::string& consumer_name,
-                                        const std::string& stream_key, int count = 1, int block_ms = 0) {
+    std::vector<StreamMessage> xreadgroup(std::string_view group_name, std::string_view consumer_name,
+                                        std::string_view stream_key, int count = 1, int block_ms = 0) {
         if (!ensure_connected()) return {};
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply;
-        if (block_ms > 0) {
-            reply = (redisReply*)redisCommand(context_, "XREADGROUP GROUP %s %s BLOCK %d COUNT %d STREAMS %s >",
-                                            group_name.c_str(), consumer_name.c_str(), block_ms, count, stream_key.c_str());
-        } else {
-            reply = (redisReply*)redisCommand(context_, "XREADGROUP GROUP %s %s COUNT %d STREAMS %s >",
-                                            group_name.c_str(), consumer_name.c_str(), count, stream_key.c_str());
-        }
-        
+        redisReply* reply = xreadgroup_command(group_name, consumer_name, stream_key, count, block_ms);
         std::vector<StreamMessage> messages = parse_xread_reply(reply);
         if (reply) freeReplyObject(reply);
         
         return messages;
     }
     
+    StreamReply xreadgroup_view(std::string_view group_name, std::string_view consumer_name,
+                                std::string_view stream_key, int count = 1, int block_ms = 0) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        return StreamReply::from_xread(xreadgroup_command(group_name, consumer_name, stream_key,
+                                                          count, block_ms));
+    }
+    
     // Acknowledge message processing
-    bool xack(const std::string& stream_key, const std::string& group_name, const std::string& message_id) {
+    bool xack(std::string_view stream_key, std::string_view group_name, std::string_view message_id) {
         if (!ensure_connected()) return false;
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply = (redisReply*)redisCommand(context_, "XACK %s %s %s",
-                                                    stream_key.c_str(), group_name.c_str(), message_id.c_str());
+        redisReply* reply = command_locked({"XACK", stream_key, group_name, message_id});
         
         bool success = (reply && reply->type == REDIS_REPLY_INTEGER && reply->integer > 0);
         if (reply) freeReplyObject(reply);
@@ -255,42 +951,76 @@ public:
         return success;
     }
     
+    // Pending-entries list summary of a group
+    PendingSummary xpending(std::string_view stream_key, std::string_view group_name) {
+        RedisCommandArgs args;
+        args.add("XPENDING").add(stream_key).add(group_name);
+        auto reply = command_argv(args.size(), args.argv(), args.lens());
+        return parse_pending_summary(reply.get());
+    }
+    
+    // Up to `count` pending entries between start and end that have been
+    // idle for at least `min_idle_ms`, oldest first
+    std::vector<PendingEntry> xpending_range(std::string_view stream_key, std::string_view group_name,
+                                             uint64_t min_idle_ms, std::string_view start = "-",
+                                             std::string_view end = "+", int count = 100) {
+        RedisCommandArgs args;
+        xpending_range_args(args, stream_key, group_name, min_idle_ms, start, end, count);
+        auto reply = command_argv(args.size(), args.argv(), args.lens());
+        return parse_pending_entries(reply.get());
+    }
+    
+    // Transfer up to `count` entries idle for at least `min_idle_ms` to
+    // `consumer_name`, scanning the PEL from `start_id` (Redis 6.2+)
+    AutoClaimResult xautoclaim(std::string_view stream_key, std::string_view group_name,
+                               std::string_view consumer_name, uint64_t min_idle_ms,
+                               std::string_view start_id = "0-0", int count = 100) {
+        RedisCommandArgs args;
+        xautoclaim_args(args, stream_key, group_name, consumer_name, min_idle_ms, start_id, count);
+        auto reply = command_argv(args.size(), args.argv(), args.lens());
+        return parse_autoclaim_reply(reply.get());
+    }
+    
+    // Argument lists shared with RedisClusterClient
+    static void xpending_range_args(RedisCommandArgs& args, std::string_view stream_key,
+                                    std::string_view group_name, uint64_t min_idle_ms,
+                                    std::string_view start, std::string_view end, int count) {
+        args.add("XPENDING").add(stream_key).add(group_name)
+            .add("IDLE").add((long long)min_idle_ms).add(start).add(end).add((long long)count);
+    }
+    
+    static void xautoclaim_args(RedisCommandArgs& args, std::string_view stream_key,
+                                std::string_view group_name, std::string_view consumer_name,
+                                uint64_t min_idle_ms, std::string_view start_id, int count) {
+        args.add("XAUTOCLAIM").add(stream_key).add(group_name).add(consumer_name)
+            .add((long long)min_idle_ms).add(start_id).add("COUNT").add((long long)count);
+    }
+    
     // Get stream info
-    std::map<std::string, std::string> xinfo_stream(const std::string& stream_key) {
+    std::map<std::string, std::string> xinfo_stream(std::string_view stream_key) {
         if (!ensure_connected()) return {};
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply = (redisReply*)redisCommand(context_, "XINFO STREAM %s", stream_key.c_str());
+        redisReply* reply = command_locked({"XINFO", "STREAM", stream_key});
         
-        std::map<std::string, std::string> info;
-        if (reply && reply->type == REDIS_REPLY_ARRAY) {
-            for (size_t i = 0; i < reply->elements; i += 2) {
-                if (i + 1 < reply->elements) {
-                    std::string key(reply->element[i]->str, reply->element[i]->len);
-                    std::string value(reply->element[i + 1]->str, reply->element[i + 1]->len);
-                    info[key] = value;
-                }
-            }
-        }
+        std::map<std::string, std::string> info = parse_info_reply(reply);
         
         if (reply) freeReplyObject(reply);
         return info;
     }
 
     // ✅ Existing operations (set, get, publish, etc.) remain the same...
-    bool set(const std::string& key, const std::string& value, int ttl_seconds = 0) {
+    bool set(std::string_view key, std::string_view value, int ttl_seconds = 0) {
         if (!ensure_connected()) return false;
         
         std::lock_guard<std::mutex> lock(mutex_);
         
         redisReply* reply;
         if (ttl_seconds > 0) {
-            reply = (redisReply*)redisCommand(context_, "SETEX %s %d %s", 
-                                            key.c_str(), ttl_seconds, value.c_str());
+            reply = command_locked({"SETEX", key, IntArg(ttl_seconds), value});
         } else {
-            reply = (redisReply*)redisCommand(context_, "SET %s %s", 
-                                            key.c_str(), value.c_str());
+            reply = command_locked({"SET", key, value});
         }
         
         bool success = (reply != nullptr && reply->type == REDIS_REPLY_STATUS);
@@ -299,13 +1029,90 @@ public:
         return success;
     }
     
-    bool publish(const std::string& channel, const std::string& message) {
+    // GET; nullopt when the key does not exist or on error
+    std::optional<std::string> get(std::string_view key) {
+        if (!ensure_connected()) return std::nullopt;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        redisReply* reply = command_locked({"GET", key});
+        
+        std::optional<std::string> value;
+        if (reply && reply->type == REDIS_REPLY_STRING) value.emplace(reply->str, reply->len);
+        if (reply) freeReplyObject(reply);
+        
+        return value;
+    }
+    
+    // XTRIM; returns the number of entries removed, -1 on error
+    long long xtrim(std::string_view stream_key, const StreamTrim& trim) {
+        if (!trim) return 0;
+        if (!ensure_connected()) return -1;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        argv_.clear();
+        argvlen_.clear();
+        argv_.push_back("XTRIM");
+        argvlen_.push_back(5);
+        argv_.push_back(stream_key.data());
+        argvlen_.push_back(stream_key.size());
+        trim.emit_args([this](const char* data, size_t len) {
+            argv_.push_back(data);
+            argvlen_.push_back(len);
+        }, trim_scratch_);
+        
+        redisReply* reply = (redisReply*)redisCommandArgv(context_, argv_.size(), argv_.data(), argvlen_.data());
+        
+        long long removed = (reply && reply->type == REDIS_REPLY_INTEGER) ? reply->integer : -1;
+        if (reply) freeReplyObject(reply);
+        return removed;
+    }
+    
+    bool hset(std::string_view key, std::string_view field, std::string_view value) {
+        if (!ensure_connected()) return false;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        redisReply* reply = command_locked({"HSET", key, field, value});
+        
+        bool success = (reply != nullptr && reply->type == REDIS_REPLY_INTEGER);
+        if (reply) freeReplyObject(reply);
+        
+        return success;
+    }
+    
+    std::map<std::string, std::string> hgetall(std::string_view key) {
+        if (!ensure_connected()) return {};
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        redisReply* reply = command_locked({"HGETALL", key});
+        std::map<std::string, std::string> hash = parse_info_reply(reply);
+        if (reply) freeReplyObject(reply);
+        
+        return hash;
+    }
+    
+    bool del(std::string_view key) {
+        if (!ensure_connected()) return false;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        redisReply* reply = command_locked({"DEL", key});
+        
+        bool success = (reply != nullptr && reply->type == REDIS_REPLY_INTEGER);
+        if (reply) freeReplyObject(reply);
+        
+        return success;
+    }
+    
+    bool publish(std::string_view channel, std::string_view message) {
         if (!ensure_connected()) return false;
         
         std::lock_guard<std::mutex> lock(mutex_);
         
-        redisReply* reply = (redisReply*)redisCommand(context_, "PUBLISH %s %s", 
-                                                    channel.c_str(), message.c_str());
+        redisReply* reply = command_locked({"PUBLISH", channel, message});
         
         bool success = (reply != nullptr && reply->type == REDIS_REPLY_INTEGER);
         if (reply) freeReplyObject(reply);
@@ -319,17 +1126,158 @@ private:
     std::string password_;
     redisContext* context_;
     bool connected_;
+    ReconnectBackoff backoff_;
+    RedisConnectionOptions options_;
     mutable std::mutex mutex_;
+    std::vector<const char*> argv_;   // reused by every command, guarded by mutex_
+    std::vector<size_t> argvlen_;
+    char trim_scratch_[48];
     
+    // Drops a connection that hit an I/O or protocol error (hiredis
+    // refuses further commands on it) and reconnects; only failed connect
+    // attempts start the backoff
     bool ensure_connected() {
-        if (!is_connected()) {
-            return connect();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (connected_ && context_ != nullptr && context_->err == 0) return true;
+            if (context_ != nullptr) {
+                std::cerr << "Redis connection lost: " << context_->errstr << std::endl;
+                redisFree(context_);
+                context_ = nullptr;
+                connected_ = false;
+            }
         }
-        return true;
+        return connect();
+    }
+    
+    template <typename Iter>
+    std::string xadd_fields(std::string_view stream_key, Iter first, Iter last, const StreamTrim& trim) {
+        if (!ensure_connected()) return "";
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Build XADD command: XADD stream_key * field1 value1 field2 value2 ...
+        // pointing straight at the caller's strings (no copies)
+        argv_.clear();
+        argvlen_.clear();
+        argv_.push_back("XADD");
+        argvlen_.push_back(4);
+        argv_.push_back(stream_key.data());
+        argvlen_.push_back(stream_key.size());
+        trim.emit_args([this](const char* data, size_t len) {
+            argv_.push_back(data);
+            argvlen_.push_back(len);
+        }, trim_scratch_);
+        argv_.push_back("*");  // Auto-generate ID
+        argvlen_.push_back(1);
+        
+        for (Iter field = first; field != last; ++field) {
+            const auto& [key, value] = *field;
+            argv_.push_back(key.data());
+            argvlen_.push_back(key.size());
+            argv_.push_back(value.data());
+            argvlen_.push_back(value.size());
+        }
+        
+        redisReply* reply = (redisReply*)redisCommandArgv(context_, argv_.size(), argv_.data(), argvlen_.data());
+        
+        std::string message_id;
+        if (reply && reply->type == REDIS_REPLY_STRING) {
+            message_id = std::string(reply->str, reply->len);
+        }
+        
+        if (reply) freeReplyObject(reply);
+        return message_id;
+    }
+    
+    // Decimal form of an integer argument, formatted in place
+    class IntArg {
+    public:
+        explicit IntArg(long long value) : len_(std::to_chars(buf_, buf_ + sizeof(buf_), value).ptr - buf_) {}
+        operator std::string_view() const { return std::string_view(buf_, len_); }
+    private:
+        char buf_[24];
+        size_t len_;
+    };
+    
+    // One command with explicit argument lengths: binary-safe, and the
+    // arguments are not copied. Caller holds mutex_ and frees the reply.
+    redisReply* command_locked(std::initializer_list<std::string_view> args) {
+        argv_.clear();
+        argvlen_.clear();
+        for (std::string_view arg : args) {
+            argv_.push_back(arg.data());
+            argvlen_.push_back(arg.size());
+        }
+        return (redisReply*)redisCommandArgv(context_, (int)argv_.size(), argv_.data(), argvlen_.data());
+    }
+    
+    // A BLOCK read may take block_ms before the reply even starts, so the
+    // command timeout is widened by that much for its duration
+    class BlockingTimeout {
+    public:
+        BlockingTimeout(RedisClient& client, int block_ms) : client_(client) {
+            if (active()) {
+                redisSetTimeout(client_.context_, RedisConnectionOptions::to_timeval(
+                    client_.options_.command_timeout + std::chrono::milliseconds(block_ms)));
+            }
+        }
+        ~BlockingTimeout() {
+            if (active() && client_.context_->err == 0) {
+                redisSetTimeout(client_.context_,
+                                RedisConnectionOptions::to_timeval(client_.options_.command_timeout));
+            }
+        }
+    private:
+        bool active() const { return client_.options_.command_timeout.count() > 0; }
+        RedisClient& client_;
+    };
+    
+    // Raw stream reads; caller holds mutex_ and frees the reply
+    redisReply* xread_command(std::string_view stream_key, std::string_view start_id,
+                              int count, int block_ms) {
+        if (block_ms > 0) {
+            // Blocking read: XREAD BLOCK timeout COUNT count STREAMS stream_key start_id
+            BlockingTimeout timeout(*this, block_ms);
+            return command_locked({"XREAD", "BLOCK", IntArg(block_ms), "COUNT", IntArg(count),
+                                   "STREAMS", stream_key, start_id});
+        }
+        // Non-blocking read: XREAD COUNT count STREAMS stream_key start_id
+        return command_locked({"XREAD", "COUNT", IntArg(count), "STREAMS", stream_key, start_id});
+    }
+    
+    redisReply* xrange_command(std::string_view stream_key, std::string_view start,
+                               std::string_view end, int count) {
+        if (count > 0) {
+            return command_locked({"XRANGE", stream_key, start, end, "COUNT", IntArg(count)});
+        }
+        return command_locked({"XRANGE", stream_key, start, end});
+    }
+    
+    redisReply* xrevrange_command(std::string_view stream_key, std::string_view end,
+                                  std::string_view start, int count) {
+        if (count > 0) {
+            return command_locked({"XREVRANGE", stream_key, end, start, "COUNT", IntArg(count)});
+        }
+        return command_locked({"XREVRANGE", stream_key, end, start});
+    }
+    
+    redisReply* xreadgroup_command(std::string_view group_name, std::string_view consumer_name,
+                                   std::string_view stream_key, int count, int block_ms) {
+        if (block_ms > 0) {
+            BlockingTimeout timeout(*this, block_ms);
+            return command_locked({"XREADGROUP", "GROUP", group_name, consumer_name, "BLOCK", IntArg(block_ms),
+                                   "COUNT", IntArg(count), "STREAMS", stream_key, ">"});
+        }
+        return command_locked({"XREADGROUP", "GROUP", group_name, consumer_name, "COUNT", IntArg(count),
+                               "STREAMS", stream_key, ">"});
     }
+
+public:
+    // Reply parsers; stateless so RedisAsyncClient can reuse them.
     
     // Parse XREAD/XREADGROUP reply
-    std::vector<StreamMessage> parse_xread_reply(redisReply* reply) {
+    static std::vector<StreamMessage> parse_xread_reply(redisReply* reply) {
         std::vector<StreamMessage> messages;
         
         if (!reply || reply->type != REDIS_REPLY_ARRAY) return messages;
@@ -343,7 +1291,7 @@ private:
                     for (size_t j = 0; j < messages_reply->elements; j++) {
                         StreamMessage msg = parse_stream_message(messages_reply->element[j]);
                         if (!msg.id.empty()) {
-                            messages.push_back(msg);
+                            messages.push_back(std::move(msg));
                         }
                     }
                 }
@@ -354,7 +1302,7 @@ private:
     }
     
     // Parse XRANGE reply  
-    std::vector<StreamMessage> parse_xrange_reply(redisReply* reply) {
+    static std::vector<StreamMessage> parse_xrange_reply(redisReply* reply) {
         std::vector<StreamMessage> messages;
         
         if (!reply || reply->type != REDIS_REPLY_ARRAY) return messages;
@@ -363,15 +1311,117 @@ private:
         for (size_t i = 0; i < reply->elements; i++) {
             StreamMessage msg = parse_stream_message(reply->element[i]);
             if (!msg.id.empty()) {
-                messages.push_back(msg);
+                messages.push_back(std::move(msg));
             }
         }
         
         return messages;
     }
     
+    // Parse XINFO/HGETALL reply: [name, value, ...]; integers are
+    // formatted, nested entries (first-entry, last-entry) are skipped
+    static std::map<std::string, std::string> parse_info_reply(redisReply* reply) {
+        std::map<std::string, std::string> info;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) return info;
+        
+        for (size_t i = 0; i + 1 < reply->elements; i += 2) {
+            redisReply* key = reply->element[i];
+            redisReply* value = reply->element[i + 1];
+            if (key->type != REDIS_REPLY_STRING && key->type != REDIS_REPLY_STATUS) continue;
+            if (value->type == REDIS_REPLY_INTEGER) {
+                info[std::string(key->str, key->len)] = std::to_string(value->integer);
+            } else if (value->type == REDIS_REPLY_STRING || value->type == REDIS_REPLY_STATUS) {
+                info[std::string(key->str, key->len)] = std::string(value->str, value->len);
+            }
+        }
+        return info;
+    }
+    
+    // XPENDING summary: [count, min-id, max-id, [[consumer, "count"], ...]]
+    static PendingSummary parse_pending_summary(redisReply* reply) {
+        PendingSummary summary;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 4) return summary;
+        
+        if (reply->element[0]->type == REDIS_REPLY_INTEGER) {
+            summary.count = (uint64_t)reply->element[0]->integer;
+        }
+        if (reply->element[1]->type == REDIS_REPLY_STRING) {
+            summary.min_id.assign(reply->element[1]->str, reply->element[1]->len);
+        }
+        if (reply->element[2]->type == REDIS_REPLY_STRING) {
+            summary.max_id.assign(reply->element[2]->str, reply->element[2]->len);
+        }
+        redisReply* consumers = reply->element[3];
+        if (consumers->type == REDIS_REPLY_ARRAY) {
+            for (size_t i = 0; i < consumers->elements; i++) {
+                redisReply* consumer = consumers->element[i];
+                if (consumer->type != REDIS_REPLY_ARRAY || consumer->elements < 2 ||
+                    consumer->element[1]->type != REDIS_REPLY_STRING) continue;
+                uint64_t pending = 0;
+                std::from_chars(consumer->element[1]->str,
+                                consumer->element[1]->str + consumer->element[1]->len, pending);
+                summary.consumers[std::string(consumer->element[0]->str, consumer->element[0]->len)] = pending;
+            }
+        }
+        return summary;
+    }
+    
+    // XPENDING extended form: [[id, consumer, idle-ms, deliveries], ...]
+    static std::vector<PendingEntry> parse_pending_entries(redisReply* reply) {
+        std::vector<PendingEntry> entries;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) return entries;
+        
+        entries.reserve(reply->elements);
+        for (size_t i = 0; i < reply->elements; i++) {
+            redisReply* item = reply->element[i];
+            if (item->type != REDIS_REPLY_ARRAY || item->elements < 4 ||
+                item->element[0]->type != REDIS_REPLY_STRING) continue;
+            PendingEntry entry;
+            entry.id.assign(item->element[0]->str, item->element[0]->len);
+            entry.consumer.assign(item->element[1]->str ? item->element[1]->str : "", item->element[1]->len);
+            entry.idle_ms = (uint64_t)item->element[2]->integer;
+            entry.deliveries = (uint64_t)item->element[3]->integer;
+            entries.push_back(std::move(entry));
+        }
+        return entries;
+    }
+    
+    // XAUTOCLAIM: [cursor, [[id, [field, value, ...]], ...], [deleted-id, ...]].
+    // Redis 6.2 has no third element and reports deleted entries as [id, nil].
+    static AutoClaimResult parse_autoclaim_reply(redisReply* reply) {
+        AutoClaimResult result;
+        if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 2) return result;
+        
+        if (reply->element[0]->type == REDIS_REPLY_STRING) {
+            result.next_id.assign(reply->element[0]->str, reply->element[0]->len);
+        }
+        redisReply* entries = reply->element[1];
+        if (entries->type == REDIS_REPLY_ARRAY) {
+            for (size_t i = 0; i < entries->elements; i++) {
+                redisReply* entry = entries->element[i];
+                if (entry->type == REDIS_REPLY_ARRAY && entry->elements >= 2 &&
+                    entry->element[0]->type == REDIS_REPLY_STRING &&
+                    entry->element[1]->type != REDIS_REPLY_ARRAY) {
+                    result.deleted_ids.emplace_back(entry->element[0]->str, entry->element[0]->len);
+                    continue;
+                }
+                StreamMessage msg = parse_stream_message(entry);
+                if (!msg.id.empty()) {
+                    result.messages.push_back(std::move(msg));
+                }
+            }
+        }
+        if (reply->elements >= 3 && reply->element[2]->type == REDIS_REPLY_ARRAY) {
+            redisReply* deleted = reply->element[2];
+            for (size_t i = 0; i < deleted->elements; i++) {
+                result.deleted_ids.emplace_back(deleted->element[i]->str, deleted->element[i]->len);
+            }
+        }
+        return result;
+    }
+    
     // Parse individual stream message: [id, [field, value, ...]]
-    StreamMessage parse_stream_message(redisReply* msg_reply) {
+    static StreamMessage parse_stream_message(redisReply* msg_reply) {
         StreamMessage message;
         
         if (!msg_reply || msg_reply->type != REDIS_REPLY_ARRAY || msg_reply->elements < 2) {
@@ -383,10 +1433,7 @@ private:
             message.id = std::string(msg_reply->element[0]->str, msg_reply->element[0]->len);
             
             // Parse timestamp from ID
-            size_t dash_pos = message.id.find('-');
-            if (dash_pos != std::string::npos) {
-                message.timestamp = std::stoull(message.id.substr(0, dash_pos));
-            }
+            message.timestamp = stream_id_timestamp(message.id);
         }
         
         // Get fields
@@ -394,9 +1441,9 @@ private:
         if (fields_reply->type == REDIS_REPLY_ARRAY) {
             for (size_t i = 0; i < fields_reply->elements; i += 2) {
                 if (i + 1 < fields_reply->elements) {
-                    std::string key(fields_reply->element[i]->str, fields_reply->element[i]->len);
-                    std::string value(fields_reply->element[i + 1]->str, fields_reply->element[i + 1]->len);
-                    message.fields[key] = value;
+                    message.fields.emplace(
+                        std::string(fields_reply->element[i]->str, fields_reply->element[i]->len),
+                        std::string(fields_reply->element[i + 1]->str, fields_reply->element[i + 1]->len));
                 }
             }
         }
@@ -405,127 +1452,1971 @@ private:
     }
 };
 
-// ✅ NEW: VLM Redis Stream Manager
-class VLMRedisStreamManager {
+
+// Pool of RedisClient connections shared by concurrent callers.
+//
+// checkout() returns a Lease on an idle connection. If none is idle and
+// fewer than `max_size` exist, it opens a new one. Otherwise it waits up to
+// `checkout_timeout` for a connection to come back. Idle connections are
+// reused most-recent first. A connection that has sat idle longer than
+// `idle_check` is PINGed before reuse and reconnected if that fails. A
+// connection that errored while leased is dropped on return and reconnects
+// on its next use. An empty Lease means no connection could be had.
+class RedisConnectionPool {
 public:
-    VLMRedisStreamManager(const std::string& redis_host = "localhost", int redis_port = 6379)
-        : redis_client_(redis_host, redis_port),
-          vlm_stream_("vlm:results:stream"),
-          frame_stream_("vlm:frames:stream"),
-          consumer_group_("vlm_processors"),
-          consumer_name_("deepstream_vlm") {
-        
-        if (!redis_client_.connect()) {
-            std::cerr << "❌ Failed to connect to Redis for VLM streams" << std::endl;
-            return;
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept : pool_(other.pool_), client_(other.client_) {
+            other.pool_ = nullptr;
+            other.client_ = nullptr;
+        }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                std::swap(pool_, other.pool_);
+                std::swap(client_, other.client_);
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        RedisClient* operator->() const { return client_; }
+        RedisClient& operator*() const { return *client_; }
+        explicit operator bool() const { return client_ != nullptr; }
+
+        // Give the connection back early
+        void release() {
+            if (pool_ && client_) {
+                pool_->give_back(client_);
+            }
+            pool_ = nullptr;
+            client_ = nullptr;
+        }
+
+    private:
+        friend class RedisConnectionPool;
+        Lease(RedisConnectionPool* pool, RedisClient* client) : pool_(pool), client_(client) {}
+
+        RedisConnectionPool* pool_ = nullptr;
+        RedisClient* client_ = nullptr;
+    };
+
+    struct Stats {
+        size_t size;          // connections opened so far
+        size_t idle;
+        uint64_t checkouts;
+        uint64_t timeouts;    // checkouts that gave up waiting
+        uint64_t reconnects;  // failed health checks / dropped connections
+    };
+
+    RedisConnectionPool(const std::string& host = "localhost", int port = 6379, size_t max_size = 4,
+                        const std::string& password = "",
+                        std::chrono::milliseconds checkout_timeout = std::chrono::milliseconds(1000),
+                        std::chrono::milliseconds idle_check = std::chrono::milliseconds(30000))
+        : host_(host), port_(port), password_(password), max_size_(max_size < 1 ? 1 : max_size),
+          checkout_timeout_(checkout_timeout), idle_check_(idle_check),
+          connected_(false), checkouts_(0), timeouts_(0), reconnects_(0) {}
+
+    RedisConnectionPool(const RedisConnectionPool&) = delete;
+    RedisConnectionPool& operator=(const RedisConnectionPool&) = delete;
+
+    Lease checkout() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        checkouts_++;
+        auto deadline = std::chrono::steady_clock::now() + checkout_timeout_;
+
+        for (;;) {
+            if (!idle_.empty()) {
+                IdleConnection entry = idle_.back();
+                idle_.pop_back();
+                lock.unlock();
+                if (std::chrono::steady_clock::now() - entry.since >= idle_check_ &&
+                    !revive(entry.client)) {
+                    give_back(entry.client);
+                    return Lease();
+                }
+                return Lease(this, entry.client);
+            }
+
+            if (clients_.size() < max_size_) {
+                clients_.push_back(std::make_unique<RedisClient>(host_, port_, password_));
+                RedisClient* client = clients_.back().get();
+                client->set_connection_options(options_);
+                lock.unlock();  // connect outside the lock
+                bool ok = client->connect();
+                connected_ = ok;
+                if (!ok) {
+                    give_back(client);
+                    return Lease();
+                }
+                return Lease(this, client);
+            }
+
+            if (available_.wait_until(lock, deadline) == std::cv_status::timeout && idle_.empty()) {
+                timeouts_++;
+                return Lease();
+            }
         }
-        
-        // Create consumer groups
-        redis_client_.xgroup_create(vlm_stream_, consumer_group_, "0");
-        redis_client_.xgroup_create(frame_stream_, consumer_group_, "0");
-        
-        std::cout << "✅ VLM Redis Streams initialized" << std::endl;
     }
-    
-    // Add VLM result to stream
-    std::string add_vlm_result(uint32_t frame_number, uint32_t source_id, 
-                              const std::string& vlm_response, const std::string& model_name = "default") {
-        std::map<std::string, std::string> fields = {
-            {"frame_number", std::to_string(frame_number)},
-            {"source_id", std::to_string(source_id)},
-            {"vlm_response", vlm_response},
-            {"model_name", model_name},
-            {"timestamp", std::to_string(get_current_timestamp())},
-            {"type", "vlm_result"}
-        };
-        
-        return redis_client_.xadd(vlm_stream_, fields);
+
+    // True if the most recent connect or health check succeeded
+    bool is_connected() const {
+        return connected_;
     }
-    
-    // Add frame metadata to stream
-    std::string add_frame_metadata(uint32_t frame_number, uint32_t source_id, 
-                                  uint32_t width, uint32_t height, const std::string& format = "NV12") {
-        std::map<std::string, std::string> fields = {
-            {"frame_number", std::to_string(frame_number)},
-            {"source_id", std::to_string(source_id)},
-            {"width", std::to_string(width)},
-            {"height", std::to_string(height)},
-            {"format", format},
-            {"timestamp", std::to_string(get_current_timestamp())},
-            {"type", "frame_metadata"}
-        };
-        
-        return redis_client_.xadd(frame_stream_, fields);
+
+    size_t max_size() const {
+        return max_size_;
     }
-    
-    // Read latest VLM results
-    std::vector<StreamMessage> get_latest_vlm_results(int count = 10, int block_ms = 1000) {
-        return redis_client_.xreadgroup(consumer_group_, consumer_name_, vlm_stream_, count, block_ms);
+
+    // Applies to connections opened after the call; set before the first
+    // checkout
+    void set_connection_options(const RedisConnectionOptions& options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
     }
-    
-    // Read VLM results in time range
-    std::vector<StreamMessage> get_vlm_results_range(uint64_t start_timestamp, uint64_t end_timestamp, int count = 100) {
-        std::string start_id = std::to_string(start_timestamp) + "-0";
-        std::string end_id = std::to_string(end_timestamp) + "-0";
-        return redis_client_.xrange(vlm_stream_, start_id, end_id, count);
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {clients_.size(), idle_.size(), checkouts_.load(), timeouts_.load(), reconnects_.load()};
     }
-    
-    // Get VLM results for specific source
-    std::vector<StreamMessage> get_vlm_results_by_source(uint32_t source_id, int count = 50) {
-        auto messages = redis_client_.xrange(vlm_stream_, "-", "+", count * 2);  // Get more to filter
-        
-        std::vector<StreamMessage> filtered;
-        for (const auto& msg : messages) {
-            if (msg.get_field_as<uint32_t>("source_id") == source_id) {
-                filtered.push_back(msg);
-                if (filtered.size() >= count) break;
+
+private:
+    struct IdleConnection {
+        RedisClient* client;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    // PING an idle connection, reconnecting once if that fails
+    bool revive(RedisClient* client) {
+        if (client->ping()) {
+            connected_ = true;
+            return true;
+        }
+        reconnects_++;
+        client->disconnect();
+        bool ok = client->connect();
+        connected_ = ok;
+        return ok;
+    }
+
+    void give_back(RedisClient* client) {
+        if (!client->healthy()) {
+            if (client->is_connected()) {
+                reconnects_++;
             }
+            client->disconnect();  // reconnects lazily on next use
         }
-        
-        return filtered;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_.push_back({client, std::chrono::steady_clock::now()});
+        }
+        available_.notify_one();
     }
-    
-    // Acknowledge processed message
-    bool ack_message(const std::string& stream, const std::string& message_id) {
-        return redis_client_.xack(stream, consumer_group_, message_id);
+
+    std::string host_;
+    int port_;
+    std::string password_;
+    const size_t max_size_;
+    const std::chrono::milliseconds checkout_timeout_;
+    const std::chrono::milliseconds idle_check_;
+    RedisConnectionOptions options_;    // guarded by mutex_
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<std::unique_ptr<RedisClient>> clients_;
+    std::vector<IdleConnection> idle_;   // most recently returned last
+
+    std::atomic<bool> connected_;
+    std::atomic<uint64_t> checkouts_;
+    std::atomic<uint64_t> timeouts_;
+    std::atomic<uint64_t> reconnects_;
+};
+
+// Redis Cluster client.
+//
+// Caches the cluster's slot map (CLUSTER SLOTS) and sends each command
+// straight to the master owning its key's hash slot, over a small
+// RedisConnectionPool per node. A MOVED reply repoints that slot, schedules
+// a full map refresh before the next command and retries on the new owner.
+// An ASK reply (slot being migrated) retries once on the target behind
+// ASKING without touching the map. TRYAGAIN and CLUSTERDOWN back off
+// briefly; an unreachable node triggers a refresh in case it failed over.
+// The stream methods mirror RedisClient's, so callers can be written once
+// for both. Every command here takes a single key.
+//
+// Redirects were checked against three redis-server 6.2 masters
+// (redis-cli --cluster create ... --cluster-replicas 0). An XADD to
+// vlm:results:{3} with its slot MIGRATING and the key already MIGRATEd
+// followed one ASK. After CLUSTER SETSLOT <slot> NODE <target> the next
+// XADD followed one MOVED, and the one after that went straight to the
+// new owner from the refreshed map.
+class RedisClusterClient {
+public:
+    struct Stats {
+        size_t nodes;         // masters in the current slot map
+        uint64_t moved;       // MOVED redirects followed
+        uint64_t asks;        // ASK redirects followed
+        uint64_t refreshes;   // slot map reloads
+        uint64_t failures;    // commands that ran out of attempts
+    };
+
+    // Nodes are always reached over TCP; a unix_socket in `options` is ignored
+    RedisClusterClient(const std::string& seed_host = "localhost", int seed_port = 6379,
+                       size_t connections_per_node = 2, const std::string& password = "",
+                       const RedisConnectionOptions& options = RedisConnectionOptions())
+        : seed_(endpoint(seed_host, seed_port)), password_(password), options_(tcp_only(options)),
+          connections_per_node_(connections_per_node < 1 ? 1 : connections_per_node),
+          slots_(kSlots, kNoNode), refresh_pending_(false),
+          moved_(0), asks_(0), refreshes_(0), failures_(0) {}
+
+    RedisClusterClient(const RedisClusterClient&) = delete;
+    RedisClusterClient& operator=(const RedisClusterClient&) = delete;
+
+    // Load the slot map through the seed node
+    bool connect() {
+        return refresh_slots();
     }
-    
-    // Get stream statistics
-    std::map<std::string, std::string> get_vlm_stream_stats() {
-        return redis_client_.xinfo_stream(vlm_stream_);
+
+    // True once a slot map has been loaded
+    bool is_connected() const {
+        std::shared_lock<std::shared_mutex> lock(topology_mutex_);
+        return !nodes_.empty();
     }
-    
+
+    // Reload the slot map from the first node that answers, seed first
+    bool refresh_slots() {
+        std::vector<std::string> candidates = {seed_};
+        {
+            std::shared_lock<std::shared_mutex> lock(topology_mutex_);
+            for (const auto& node : nodes_) {
+                if (node != seed_) candidates.push_back(node);
+            }
+        }
+        for (const auto& node : candidates) {
+            if (load_slots_from(node)) return true;
+        }
+        std::cerr << "❌ Redis cluster: no node answered CLUSTER SLOTS" << std::endl;
+        return false;
+    }
+
+    // Send a single-key command to the node owning `key`, following
+    // redirects. Returns the final reply (possibly an ordinary error such as
+    // BUSYGROUP) or null if no node could serve it.
+    std::shared_ptr<redisReply> execute(std::string_view key, RedisCommandArgs& args) {
+        if (refresh_pending_.exchange(false) || !is_connected()) {
+            refresh_slots();
+        }
+        uint16_t slot = redis_key_hash_slot(key);
+        std::string node = node_for_slot(slot);
+        bool asking = false;
+
+        for (int attempt = 0; attempt < kMaxAttempts; attempt++) {
+            if (node.empty()) {
+                if (!refresh_slots() || (node = node_for_slot(slot)).empty()) break;
+            }
+
+            std::shared_ptr<redisReply> reply;
+            if (auto conn = pool_for(node)->checkout()) {
+                reply = conn->command_argv(args.size(), args.argv(), args.lens(), asking);
+            }
+            asking = false;
+
+            if (!reply) {
+                // Node unreachable; it may have been failed over
+                refresh_slots();
+                node = node_for_slot(slot);
+                continue;
+            }
+            if (reply->type != REDIS_REPLY_ERROR) return reply;
+
+            std::string_view error(reply->str, reply->len);
+            if (starts_with(error, "MOVED ")) {
+                moved_++;
+                node = redirect_target(error, node);
+                assign_slot(slot, node);
+                refresh_pending_ = true;
+            } else if (starts_with(error, "ASK ")) {
+                asks_++;
+                node = redirect_target(error, node);
+                asking = true;
+            } else if (starts_with(error, "TRYAGAIN") || starts_with(error, "CLUSTERDOWN")) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10 * (attempt + 1)));
+                if (starts_with(error, "CLUSTERDOWN")) refresh_pending_ = true;
+            } else {
+                return reply;
+            }
+        }
+        failures_++;
+        return nullptr;
+    }
+
+    std::string xadd(std::string_view stream_key, const std::map<std::string, std::string>& fields,
+                     const StreamTrim& trim = StreamTrim()) {
+        return xadd_fields(stream_key, fields.begin(), fields.end(), trim);
+    }
+
+    std::string xadd(std::string_view stream_key, const StreamFieldView* fields, size_t count,
+                     const StreamTrim& trim = StreamTrim()) {
+        return xadd_fields(stream_key, fields, fields + count, trim);
+    }
+
+    std::vector<StreamMessage> xrange(const std::string& stream_key, const std::string& start = "-",
+                                      const std::string& end = "+", int count = -1) {
+        auto reply = range_command("XRANGE", stream_key, start, end, count);
+        return RedisClient::parse_xrange_reply(reply.get());
+    }
+
+    StreamReply xrange_view(const std::string& stream_key, const std::string& start = "-",
+                            const std::string& end = "+", int count = -1) {
+        return StreamReply::from_xrange(range_command("XRANGE", stream_key, start, end, count));
+    }
+
+    std::vector<StreamMessage> xrevrange(const std::string& stream_key, const std::string& end = "+",
+                                         const std::string& start = "-", int count = -1) {
+        auto reply = range_command("XREVRANGE", stream_key, end, start, count);
+        return RedisClient::parse_xrange_reply(reply.get());
+    }
+
+    StreamReply xrevrange_view(const std::string& stream_key, const std::string& end = "+",
+                               const std::string& start = "-", int count = -1) {
+        return StreamReply::from_xrange(range_command("XREVRANGE", stream_key, end, start, count));
+    }
+
+    bool xgroup_create(const std::string& stream_key, const std::string& group_name,
+                       const std::string& start_id = "$") {
+        RedisCommandArgs args;
+        args.add("XGROUP").add("CREATE").add(stream_key).add(group_name).add(start_id).add("MKSTREAM");
+        auto reply = execute(stream_key, args);
+        if (!reply) return false;
+        if (reply->type == REDIS_REPLY_ERROR) {
+            return std::string_view(reply->str, reply->len).find("BUSYGROUP") != std::string_view::npos;
+        }
+        return true;
+    }
+
+    std::vector<StreamMessage> xreadgroup(const std::string& group_name, const std::string& consumer_name,
+                                          const std::string& stream_key, int count = 1, int block_ms = 0) {
+        auto reply = xreadgroup_command(group_name, consumer_name, stream_key, count, block_ms);
+        return RedisClient::parse_xread_reply(reply.get());
+    }
+
+    StreamReply xreadgroup_view(const std::string& group_name, const std::string& consumer_name,
+                                const std::string& stream_key, int count = 1, int block_ms = 0) {
+        return StreamReply::from_xread(xreadgroup_command(group_name, consumer_name, stream_key,
+                                                          count, block_ms));
+    }
+
+    bool xack(const std::string& stream_key, const std::string& group_name, const std::string& message_id) {
+        RedisCommandArgs args;
+        args.add("XACK").add(stream_key).add(group_name).add(message_id);
+        auto reply = execute(stream_key, args);
+        return reply && reply->type == REDIS_REPLY_INTEGER && reply->integer > 0;
+    }
+
+    PendingSummary xpending(const std::string& stream_key, const std::string& group_name) {
+        RedisCommandArgs args;
+        args.add("XPENDING").add(stream_key).add(group_name);
+        auto reply = execute(stream_key, args);
+        return RedisClient::parse_pending_summary(reply.get());
+    }
+
+    std::vector<PendingEntry> xpending_range(const std::string& stream_key, const std::string& group_name,
+                                             uint64_t min_idle_ms, const std::string& start = "-",
+                                             const std::string& end = "+", int count = 100) {
+        RedisCommandArgs args;
+        RedisClient::xpending_range_args(args, stream_key, group_name, min_idle_ms, start, end, count);
+        auto reply = execute(stream_key, args);
+        return RedisClient::parse_pending_entries(reply.get());
+    }
+
+    AutoClaimResult xautoclaim(const std::string& stream_key, const std::string& group_name,
+                               const std::string& consumer_name, uint64_t min_idle_ms,
+                               const std::string& start_id = "0-0", int count = 100) {
+        RedisCommandArgs args;
+        RedisClient::xautoclaim_args(args, stream_key, group_name, consumer_name, min_idle_ms,
+                                     start_id, count);
+        auto reply = execute(stream_key, args);
+        return RedisClient::parse_autoclaim_reply(reply.get());
+    }
+
+    std::map<std::string, std::string> xinfo_stream(const std::string& stream_key) {
+        RedisCommandArgs args;
+        args.add("XINFO").add("STREAM").add(stream_key);
+        auto reply = execute(stream_key, args);
+        return RedisClient::parse_info_reply(reply.get());
+    }
+
+    long long xtrim(const std::string& stream_key, const StreamTrim& trim) {
+        if (!trim) return 0;
+        RedisCommandArgs args;
+        args.add("XTRIM").add(stream_key).add(trim);
+        auto reply = execute(stream_key, args);
+        return (reply && reply->type == REDIS_REPLY_INTEGER) ? reply->integer : -1;
+    }
+
+    bool set(std::string_view key, std::string_view value, int ttl_seconds = 0) {
+        RedisCommandArgs args;
+        if (ttl_seconds > 0) {
+            args.add("SETEX").add(key).add((long long)ttl_seconds).add(value);
+        } else {
+            args.add("SET").add(key).add(value);
+        }
+        auto reply = execute(key, args);
+        return reply && reply->type == REDIS_REPLY_STATUS;
+    }
+
+    std::optional<std::string> get(std::string_view key) {
+        RedisCommandArgs args;
+        args.add("GET").add(key);
+        auto reply = execute(key, args);
+        if (!reply || reply->type != REDIS_REPLY_STRING) return std::nullopt;
+        return std::string(reply->str, reply->len);
+    }
+
+    bool hset(std::string_view key, std::string_view field, std::string_view value) {
+        RedisCommandArgs args;
+        args.add("HSET").add(key).add(field).add(value);
+        auto reply = execute(key, args);
+        return reply && reply->type == REDIS_REPLY_INTEGER;
+    }
+
+    std::map<std::string, std::string> hgetall(std::string_view key) {
+        RedisCommandArgs args;
+        args.add("HGETALL").add(key);
+        auto reply = execute(key, args);
+        return RedisClient::parse_info_reply(reply.get());
+    }
+
+    bool del(const std::string& key) {
+        RedisCommandArgs args;
+        args.add("DEL").add(key);
+        auto reply = execute(key, args);
+        return reply && reply->type == REDIS_REPLY_INTEGER;
+    }
+
+    Stats stats() const {
+        size_t nodes;
+        {
+            std::shared_lock<std::shared_mutex> lock(topology_mutex_);
+            nodes = nodes_.size();
+        }
+        return {nodes, moved_.load(), asks_.load(), refreshes_.load(), failures_.load()};
+    }
+
+private:
+    template <typename Iter>
+    std::string xadd_fields(std::string_view stream_key, Iter first, Iter last, const StreamTrim& trim) {
+        RedisCommandArgs args;
+        args.add("XADD").add(stream_key).add(trim).add("*");
+        for (Iter field = first; field != last; ++field) {
+            args.add(field->first).add(field->second);
+        }
+        auto reply = execute(stream_key, args);
+        return (reply && reply->type == REDIS_REPLY_STRING) ? std::string(reply->str, reply->len) : "";
+    }
+
+    static constexpr size_t kSlots = 16384;
+    static constexpr uint16_t kNoNode = 0xFFFF;
+    static constexpr int kMaxAttempts = 5;
+
+    static std::string endpoint(const std::string& host, int port) {
+        return host + ":" + std::to_string(port);
+    }
+
+    static bool starts_with(std::string_view text, std::string_view prefix) {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+
+    // "MOVED <slot> <host>:<port>" / "ASK <slot> <host>:<port>". An empty
+    // host means the node that sent the redirect.
+    static std::string redirect_target(std::string_view error, const std::string& current) {
+        size_t space = error.rfind(' ');
+        std::string target(error.substr(space + 1));
+        if (!target.empty() && target[0] == ':') {
+            target.insert(0, current.substr(0, current.rfind(':')));
+        }
+        return target;
+    }
+
+    std::string node_for_slot(uint16_t slot) const {
+        std::shared_lock<std::shared_mutex> lock(topology_mutex_);
+        uint16_t index = slots_[slot];
+        return index == kNoNode ? std::string() : nodes_[index];
+    }
+
+    void assign_slot(uint16_t slot, const std::string& node) {
+        std::unique_lock<std::shared_mutex> lock(topology_mutex_);
+        auto it = std::find(nodes_.begin(), nodes_.end(), node);
+        if (it == nodes_.end()) {
+            it = nodes_.insert(nodes_.end(), node);
+        }
+        slots_[slot] = (uint16_t)(it - nodes_.begin());
+    }
+
+    // Pools are created on first use and live as long as the client
+    RedisConnectionPool* pool_for(const std::string& node) {
+        std::lock_guard<std::mutex> lock(pools_mutex_);
+        auto& pool = pools_[node];
+        if (!pool) {
+            size_t colon = node.rfind(':');
+            pool = std::make_unique<RedisConnectionPool>(node.substr(0, colon), std::stoi(node.substr(colon + 1)),
+                                                         connections_per_node_, password_);
+            pool->set_connection_options(options_);
+        }
+        return pool.get();
+    }
+
+    // CLUSTER SLOTS: [[first, last, [host, port, id, ...], replica...], ...]
+    bool load_slots_from(const std::string& node) {
+        std::shared_ptr<redisReply> reply;
+        if (auto conn = pool_for(node)->checkout()) {
+            const char* argv[] = {"CLUSTER", "SLOTS"};
+            size_t argvlen[] = {7, 5};
+            reply = conn->command_argv(2, argv, argvlen);
+        }
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) {
+            if (reply && reply->type == REDIS_REPLY_ERROR) {
+                std::cerr << "Redis CLUSTER SLOTS error from " << node << ": "
+                          << std::string(reply->str, reply->len) << std::endl;
+            }
+            return false;
+        }
+
+        std::vector<uint16_t> slots(kSlots, kNoNode);
+        std::vector<std::string> nodes;
+        std::string default_host = node.substr(0, node.rfind(':'));
+        for (size_t i = 0; i < reply->elements; i++) {
+            redisReply* range = reply->element[i];
+            if (range->type != REDIS_REPLY_ARRAY || range->elements < 3) continue;
+            redisReply* master = range->element[2];
+            if (master->type != REDIS_REPLY_ARRAY || master->elements < 2 ||
+                master->element[0]->type != REDIS_REPLY_STRING) continue;
+
+            std::string host(master->element[0]->str, master->element[0]->len);
+            if (host.empty() || host == "?") host = default_host;
+            std::string owner = endpoint(host, (int)master->element[1]->integer);
+            auto it = std::find(nodes.begin(), nodes.end(), owner);
+            if (it == nodes.end()) {
+                it = nodes.insert(nodes.end(), owner);
+            }
+            long long first = std::max(0LL, range->element[0]->integer);
+            long long last = std::min((long long)kSlots - 1, range->element[1]->integer);
+            for (long long slot = first; slot <= last; slot++) {
+                slots[slot] = (uint16_t)(it - nodes.begin());
+            }
+        }
+        if (nodes.empty()) return false;
+
+        {
+            std::unique_lock<std::shared_mutex> lock(topology_mutex_);
+            slots_.swap(slots);
+            nodes_.swap(nodes);
+        }
+        refreshes_++;
+        return true;
+    }
+
+    std::shared_ptr<redisReply> range_command(const char* command, const std::string& stream_key,
+                                              const std::string& from, const std::string& to, int count) {
+        RedisCommandArgs args;
+        args.add(command).add(stream_key).add(from).add(to);
+        if (count > 0) {
+            args.add("COUNT").add((long long)count);
+        }
+        return execute(stream_key, args);
+    }
+
+    std::shared_ptr<redisReply> xreadgroup_command(const std::string& group_name,
+                                                   const std::string& consumer_name,
+                                                   const std::string& stream_key, int count, int block_ms) {
+        RedisCommandArgs args;
+        args.add("XREADGROUP").add("GROUP").add(group_name).add(consumer_name);
+        if (block_ms > 0) {
+            args.add("BLOCK").add((long long)block_ms);
+        }
+        args.add("COUNT").add((long long)count).add("STREAMS").add(stream_key).add(">");
+        return execute(stream_key, args);
+    }
+
+    static RedisConnectionOptions tcp_only(RedisConnectionOptions options) {
+        options.unix_socket.clear();
+        return options;
+    }
+
+    const std::string seed_;
+    const std::string password_;
+    const RedisConnectionOptions options_;
+    const size_t connections_per_node_;
+
+    mutable std::shared_mutex topology_mutex_;
+    std::vector<uint16_t> slots_;        // slot -> index into nodes_
+    std::vector<std::string> nodes_;     // "host:port" of each master
+
+    std::mutex pools_mutex_;
+    std::map<std::string, std::unique_ptr<RedisConnectionPool>> pools_;
+
+    std::atomic<bool> refresh_pending_;
+    std::atomic<uint64_t> moved_;
+    std::atomic<uint64_t> asks_;
+    std::atomic<uint64_t> refreshes_;
+    std::atomic<uint64_t> failures_;
+};
+
+// Pipelined XADD writer on its own connection.
+//
+// xadd() only appends the command to an in-memory batch and returns a
+// future for the message ID. A flusher thread sends the batch with
+// redisAppendCommandArgv once `max_batch` commands are pending or
+// `flush_interval` has passed since the first one, then reads all replies
+// in order. Entries queued while a round trip is in flight join the next
+// batch, which may then exceed `max_batch`. One round trip is paid per batch
+// instead of per entry, and arguments are packed into reused buffers, so
+// steady-state xadd() does not allocate. Failed commands resolve to an empty
+// ID. Reconnects back off like RedisClient's; with a spill handler set,
+// commands lost to a connection failure are passed to it before their
+// futures resolve.
+class RedisPipelinedWriter {
+public:
+    // Gets one failed command in argv form; true if it was kept
+    using SpillHandler = std::function<bool(size_t argc, const char** argv, const size_t* argvlen)>;
+
+    struct Stats {
+        uint64_t commands;   // commands sent
+        uint64_t flushes;    // round trips
+        uint64_t errors;     // commands that resolved to an empty ID
+    };
+
+    RedisPipelinedWriter(const std::string& host = "localhost", int port = 6379,
+                         size_t max_batch = 64,
+                         std::chrono::microseconds flush_interval = std::chrono::microseconds(500),
+                         const std::string& password = "",
+                         const RedisConnectionOptions& options = RedisConnectionOptions())
+        : host_(host), port_(port), password_(password), options_(options),
+          max_batch_(max_batch < 1 ? 1 : max_batch), flush_interval_(flush_interval),
+          context_(nullptr), stop_(false), flush_requested_(false),
+          commands_(0), flushes_(0), errors_(0) {
+        flusher_ = std::thread(&RedisPipelinedWriter::flush_loop, this);
+    }
+
+    ~RedisPipelinedWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        if (flusher_.joinable()) {
+            flusher_.join();  // drains whatever is still pending
+        }
+        if (context_) {
+            redisFree(context_);
+        }
+    }
+
+    RedisPipelinedWriter(const RedisPipelinedWriter&) = delete;
+    RedisPipelinedWriter& operator=(const RedisPipelinedWriter&) = delete;
+
+    // Queue XADD stream_key * field value ... ; never blocks on the network.
+    std::future<std::string> xadd(std::string_view stream_key,
+                                  const std::map<std::string, std::string>& fields,
+                                  const StreamTrim& trim = StreamTrim()) {
+        return queue_fields(stream_key, fields.begin(), fields.end(), trim);
+    }
+
+    std::future<std::string> xadd(std::string_view stream_key, const StreamFieldView* fields, size_t count,
+                                  const StreamTrim& trim = StreamTrim()) {
+        return queue_fields(stream_key, fields, fields + count, trim);
+    }
+
+    // Send whatever is pending without waiting for the batch to fill.
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_requested_ = true;
+        cond_.notify_one();
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    bool is_connected() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return connected_flag_;
+    }
+
+    Stats stats() const {
+        return {commands_.load(), flushes_.load(), errors_.load()};
+    }
+    
+    // Set before the first xadd()
+    void set_spill_handler(SpillHandler spill) {
+        spill_ = std::move(spill);
+    }
+
+private:
+    template <typename Iter>
+    std::future<std::string> queue_fields(std::string_view stream_key, Iter first, Iter last,
+                                          const StreamTrim& trim) {
+        std::promise<std::string> promise;
+        std::future<std::string> future = promise.get_future();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            promise.set_value("");
+            return future;
+        }
+        size_t first_arg = pending_.arg_lens.size();
+        pending_.append("XADD", 4);
+        pending_.append(stream_key.data(), stream_key.size());
+        char scratch[48];
+        trim.emit_args([this](const char* data, size_t len) {
+            pending_.append(data, len);  // copied, scratch may go away
+        }, scratch);
+        pending_.append("*", 1);
+        for (Iter field = first; field != last; ++field) {
+            const auto& [key, value] = *field;
+            pending_.append(key.data(), key.size());
+            pending_.append(value.data(), value.size());
+        }
+        pending_.argc.push_back(pending_.arg_lens.size() - first_arg);
+        pending_.promises.push_back(std::move(promise));
+
+        if (pending_.size() == 1) {
+            first_pending_ = std::chrono::steady_clock::now();
+            cond_.notify_one();
+        } else if (pending_.size() >= max_batch_) {
+            cond_.notify_one();
+        }
+        return future;
+    }
+
+    // Commands packed back to back: every argument in one string, with a
+    // parallel length per argument and an argument count per command.
+    struct Batch {
+        std::string args;
+        std::vector<size_t> arg_lens;
+        std::vector<size_t> argc;
+        std::vector<std::promise<std::string>> promises;
+
+        void append(const char* data, size_t len) {
+            args.append(data, len);
+            arg_lens.push_back(len);
+        }
+        size_t size() const { return promises.size(); }
+        void clear() {
+            args.clear();
+            arg_lens.clear();
+            argc.clear();
+            promises.clear();
+        }
+    };
+
+    void flush_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cond_.wait(lock, [this] { return stop_ || pending_.size() > 0; });
+            if (pending_.size() == 0) {
+                break;  // stopped and drained
+            }
+            if (!stop_ && !flush_requested_ && pending_.size() < max_batch_) {
+                cond_.wait_until(lock, first_pending_ + flush_interval_, [this] {
+                    return stop_ || flush_requested_ || pending_.size() >= max_batch_;
+                });
+            }
+            flush_requested_ = false;
+            std::swap(pending_, sending_);
+
+            lock.unlock();
+            send(sending_);
+            sending_.clear();  // keeps capacity for the next swap
+            lock.lock();
+        }
+    }
+
+    // Flusher thread only.
+    void send(Batch& batch) {
+        size_t count = batch.size();
+        if (!ensure_connected()) {
+            fail(batch, 0);
+            return;
+        }
+
+        const char* data = batch.args.data();
+        const size_t* lens = batch.arg_lens.data();
+        for (size_t i = 0; i < count; i++) {
+            size_t argc = batch.argc[i];
+            argv_.clear();
+            for (size_t j = 0; j < argc; j++) {
+                argv_.push_back(data);
+                data += lens[j];
+            }
+            redisAppendCommandArgv(context_, (int)argc, argv_.data(), lens);
+            lens += argc;
+        }
+        flushes_.fetch_add(1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < count; i++) {
+            redisReply* reply = nullptr;
+            if (redisGetReply(context_, (void**)&reply) != REDIS_OK) {
+                std::cerr << "Redis pipeline error: " << context_->errstr << std::endl;
+                drop_connection();
+                fail(batch, i);
+                return;
+            }
+            std::string message_id;
+            if (reply && reply->type == REDIS_REPLY_STRING) {
+                message_id.assign(reply->str, reply->len);
+            } else {
+                errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (reply) freeReplyObject(reply);
+            commands_.fetch_add(1, std::memory_order_relaxed);
+            batch.promises[i].set_value(std::move(message_id));
+        }
+    }
+
+    // Commands from `from` on never got a reply. Flusher thread only.
+    void fail(Batch& batch, size_t from) {
+        const char* data = batch.args.data();
+        const size_t* lens = batch.arg_lens.data();
+        for (size_t i = 0; i < batch.size(); i++) {
+            size_t argc = batch.argc[i];
+            if (i >= from) {
+                if (spill_) {
+                    argv_.clear();
+                    const char* arg = data;
+                    for (size_t j = 0; j < argc; j++) {
+                        argv_.push_back(arg);
+                        arg += lens[j];
+                    }
+                    spill_(argc, argv_.data(), lens);
+                }
+                batch.promises[i].set_value("");
+            }
+            for (size_t j = 0; j < argc; j++) {
+                data += lens[j];
+            }
+            lens += argc;
+        }
+        errors_.fetch_add(batch.size() - from, std::memory_order_relaxed);
+    }
+
+    // Flusher thread only.
+    bool ensure_connected() {
+        if (context_) return true;
+        if (!backoff_.ready()) return false;
+
+        context_ = options_.connect(host_, port_);
+        if (context_ == nullptr || context_->err) {
+            if (context_) {
+                if (backoff_.failures() == 0) {
+                    std::cerr << "Redis pipeline connection error: " << context_->errstr << std::endl;
+                }
+                redisFree(context_);
+                context_ = nullptr;
+            }
+            backoff_.failed();
+            return false;
+        }
+
+        if (!password_.empty()) {
+            const char* argv[] = {"AUTH", password_.data()};
+            size_t argvlen[] = {4, password_.size()};
+            redisReply* reply = (redisReply*)redisCommandArgv(context_, 2, argv, argvlen);
+            bool ok = reply && reply->type != REDIS_REPLY_ERROR;
+            if (reply) freeReplyObject(reply);
+            if (!ok) {
+                std::cerr << "Redis pipeline auth error" << std::endl;
+                redisFree(context_);
+                context_ = nullptr;
+                backoff_.failed();
+                return false;
+            }
+        }
+        backoff_.succeeded();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        connected_flag_ = true;
+        return true;
+    }
+
+    void drop_connection() {
+        redisFree(context_);
+        context_ = nullptr;
+        std::lock_guard<std::mutex> lock(mutex_);
+        connected_flag_ = false;
+    }
+
+    std::string host_;
+    int port_;
+    std::string password_;
+    const RedisConnectionOptions options_;
+    const size_t max_batch_;
+    const std::chrono::microseconds flush_interval_;
+
+    redisContext* context_;              // flusher thread only
+    std::vector<const char*> argv_;      // flusher thread only
+    Batch sending_;                      // flusher thread only
+    ReconnectBackoff backoff_;           // flusher thread only
+    SpillHandler spill_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    Batch pending_;
+    std::chrono::steady_clock::time_point first_pending_;
+    bool stop_;
+    bool flush_requested_;
+    bool connected_flag_ = false;
+    std::thread flusher_;
+
+    std::atomic<uint64_t> commands_;
+    std::atomic<uint64_t> flushes_;
+    std::atomic<uint64_t> errors_;
+};
+
+// Where VLM results are written
+enum class StreamLayout {
+    GLOBAL,    // vlm:results:stream only
+    SHARDED,   // vlm:results:{<source_id>} only
+    BOTH       // both; the global stream keeps feeding existing readers
+};
+
+// Pending-entry recovery for the VLM result consumer group. Entries a
+// consumer read but never acknowledged (it crashed, or hung) stay in the
+// group's PEL. Once idle for `min_idle` they are claimed by the recovering
+// consumer, and after `max_deliveries` failed deliveries they are moved to
+// the dead-letter stream and acknowledged instead of being retried forever.
+// A process that publishes but never reads the stream sets `claim` to
+// false: it only dead-letters, since entries it claimed would never be
+// processed.
+struct PendingRecovery {
+    std::chrono::milliseconds min_idle{60000};
+    std::chrono::milliseconds interval{10000};
+    uint64_t max_deliveries = 5;
+    int batch = 100;   // entries examined per command
+    bool claim = true;
+};
+
+// ✅ NEW: VLM Redis Stream Manager
+class VLMRedisStreamManager {
+public:
+    // With `cluster` the host/port is a seed node of a Redis Cluster and
+    // `pool_size` connections are kept per master. `options` apply to every
+    // connection the manager opens (a Unix socket only outside cluster mode).
+    VLMRedisStreamManager(const std::string& redis_host = "localhost", int redis_port = 6379,
+                          size_t pool_size = 4, bool cluster = false,
+                          const RedisConnectionOptions& options = RedisConnectionOptions())
+        : redis_host_(redis_host),
+          redis_port_(redis_port),
+          options_(options),
+          vlm_stream_("vlm:results:stream"),
+          frame_stream_("vlm:frames:stream"),
+          consumer_group_("vlm_processors"),
+          consumer_name_(default_consumer_name()) {
+        
+        if (cluster) {
+            cluster_ = std::make_unique<RedisClusterClient>(redis_host, redis_port, pool_size, "", options_);
+            cluster_->connect();
+        } else {
+            pool_ = std::make_unique<RedisConnectionPool>(redis_host, redis_port, pool_size);
+            pool_->set_connection_options(options_);
+        }
+        
+        // Create consumer groups
+        bool ready = with_connection<bool>([this](auto& redis) {
+            redis.xgroup_create(vlm_stream_, consumer_group_, "0");
+            redis.xgroup_create(frame_stream_, consumer_group_, "0");
+            return redis.is_connected();
+        });
+        if (!ready) {
+            std::cerr << "❌ Failed to connect to Redis for VLM streams" << std::endl;
+            return;
+        }
+        
+        std::cout << "✅ VLM Redis Streams initialized" << (cluster_ ? " (cluster)" : "") << std::endl;
+    }
+    
+    // Send add_vlm_result_async/add_frame_metadata_async through a
+    // RedisPipelinedWriter on a second connection, so queued entries share
+    // round trips. The blocking add_vlm_result/add_frame_metadata keep
+    // using a pooled connection: waiting on a pipelined entry would add the
+    // batching delay to every call. Entries written both ways are not
+    // ordered with each other. max_batch == 0 turns pipelining off. Call
+    // before publishing starts.
+    // Not available in cluster mode, where the writer's single connection
+    // cannot follow slot ownership.
+    void enable_pipelining(size_t max_batch,
+                           std::chrono::microseconds flush_interval = std::chrono::microseconds(500)) {
+        if (max_batch == 0) {
+            writer_.reset();
+            return;
+        }
+        if (cluster_) {
+            std::cerr << "Redis pipelining is not supported in cluster mode, using blocking XADD" << std::endl;
+            return;
+        }
+        writer_ = std::make_unique<RedisPipelinedWriter>(redis_host_, redis_port_,
+                                                         max_batch, flush_interval, "", options_);
+        if (spill_) {
+            hook_writer_spill();
+        }
+    }
+    
+    // Keep XADDs that cannot reach Redis in an on-disk spill log under
+    // `dir` (at most `max_bytes`) and replay them in order, batched, once
+    // Redis is reachable again. While anything is waiting to be replayed new
+    // results are spilled too, so they stay behind the older ones. Spilled
+    // results return an empty ID. Each is given its stream ID when it is
+    // spilled, so a replayed entry keeps the time it was published (compact
+    // entries carry no other timestamp); one whose ID is no longer above the
+    // stream's last entry, because something else wrote to the stream in
+    // the meantime, is replayed with a fresh ID instead. Not available in
+    // cluster mode. Call before publishing starts.
+    bool enable_spill(const std::string& dir, size_t max_bytes = 128 << 20,
+                      size_t segment_bytes = 8 << 20) {
+        if (cluster_) {
+            std::cerr << "Redis spill log is not supported in cluster mode" << std::endl;
+            return false;
+        }
+        stop_replay();
+        spill_ = std::make_unique<RedisSpillLog>(dir, segment_bytes,
+                                                 std::max<size_t>(1, max_bytes / segment_bytes));
+        if (writer_) {
+            hook_writer_spill();
+        }
+        {
+            std::lock_guard<std::mutex> lock(replay_mutex_);
+            replay_stop_ = false;
+        }
+        replay_thread_ = std::thread(&VLMRedisStreamManager::replay_loop, this);
+        return true;
+    }
+    
+    // All zero when the spill log is off
+    RedisSpillLog::Stats get_spill_stats() const {
+        return spill_ ? spill_->stats() : RedisSpillLog::Stats{0, 0, 0, 0, 0};
+    }
+    
+    bool is_pipelined() const {
+        return writer_ != nullptr;
+    }
+    
+    // Write each VLM result as one compact MessagePack field (see
+    // VLMResultCodec) instead of six strings, compressing responses of at
+    // least `min_compress_bytes` when this build has `compression`. Model
+    // names are interned in the vlm:models hash. The reads below decode
+    // both encodings; *_view reads return entries as stored. Call before
+    // publishing starts.
+    void enable_compact_encoding(VLMCompression compression = VLMCompression::NONE,
+                                 size_t min_compress_bytes = 512) {
+        if (!VLMResultCodec::available(compression)) {
+            std::cerr << "VLM result compression not built in, storing responses uncompressed" << std::endl;
+        }
+        codec_ = std::make_unique<VLMResultCodec>(compression, min_compress_bytes);
+    }
+    
+    bool is_compact() const {
+        return codec_ != nullptr;
+    }
+    
+    // Write results to the global stream, to per-source streams
+    // (vlm:results:{<source_id>}) or both. Call before publishing starts.
+    void set_stream_layout(StreamLayout layout) {
+        layout_ = layout;
+    }
+    
+    StreamLayout get_stream_layout() const {
+        return layout_;
+    }
+    
+    // Per-source stream of `source_id`. The ID is the key's hash tag, so in
+    // a cluster each source's stream hashes by its ID alone and sources
+    // spread across the masters.
+    std::string source_stream(uint32_t source_id) const {
+        return source_stream_prefix_ + "{" + std::to_string(source_id) + "}";
+    }
+    
+    bool is_cluster() const {
+        return cluster_ != nullptr;
+    }
+    
+    // Add VLM result to stream. The returned ID is the global stream's
+    // unless the layout is SHARDED. A `cached` result is one reused from an
+    // earlier, near-identical frame instead of asked of the backend; its
+    // entry carries cached=1.
+    std::string add_vlm_result(uint32_t frame_number, uint32_t source_id, 
+                              const std::string& vlm_response, const std::string& model_name = "default",
+                              bool cached = false) {
+        return publish_vlm_result(source_id, vlm_result_fields(frame_number, source_id,
+                                                               vlm_response, model_name, cached));
+    }
+    
+    // Queue a VLM result; the future resolves to the message ID ("" on error).
+    // Falls back to a blocking XADD when pipelining is off. Callers that
+    // publish several results should queue them all before waiting on any.
+    std::future<std::string> add_vlm_result_async(uint32_t frame_number, uint32_t source_id,
+                                                  const std::string& vlm_response,
+                                                  const std::string& model_name = "default",
+                                                  bool cached = false) {
+        auto fields = vlm_result_fields(frame_number, source_id, vlm_response, model_name, cached);
+        if (!writer_) {
+            return ready_future(publish_vlm_result(source_id, fields));
+        }
+        std::future<std::string> message_id;
+        if (layout_ != StreamLayout::SHARDED) {
+            message_id = queue_xadd(vlm_stream_, fields, vlm_trim_);
+        }
+        if (layout_ != StreamLayout::GLOBAL) {
+            note_source(source_id);
+            auto shard_id = queue_xadd(source_stream(source_id), fields, vlm_trim_);
+            if (layout_ == StreamLayout::SHARDED) {
+                message_id = std::move(shard_id);
+            }
+        }
+        return message_id;
+    }
+    
+    // Add a partial VLM result, the response generated so far for a frame
+    // (cumulative, not a delta) after `tokens` streamed tokens, to the
+    // partial stream. Readers show it until the frame's final entry arrives
+    // on the result stream. Partials are superseded within seconds, so they
+    // are always written plainly with a blocking XADD and never spilled.
+    std::string add_vlm_partial(uint32_t frame_number, uint32_t source_id,
+                                const std::string& vlm_response, const std::string& model_name,
+                                uint64_t tokens) {
+        auto fields = vlm_partial_fields(frame_number, source_id, vlm_response, model_name, tokens);
+        return with_connection<std::string>([&](auto& redis) {
+            return redis.xadd(partial_stream_, fields, partial_trim_);
+        });
+    }
+    
+    // Stream and trimming used by add_vlm_partial. Capped at about 10000
+    // entries by default.
+    void configure_partial_stream(const std::string& stream, const StreamTrim& trim) {
+        partial_stream_ = stream;
+        partial_trim_ = trim;
+    }
+    
+    const std::string& partial_stream() const {
+        return partial_stream_;
+    }
+    
+    // Shared VLM response cache, so that nodes publishing to the same Redis
+    // reuse each other's answers. Entries are plain keys,
+    // vlm:cache:<prompt key>:<image hash> in hex, expiring after
+    // `ttl_seconds`; only exact hash matches are found here. The value is
+    // opaque to the manager. Nothing is stored without a positive TTL, so
+    // a shared entry can never outlive its usefulness.
+    std::optional<std::string> get_cached_response(uint64_t prompt_key, uint64_t image_hash) {
+        std::string key = cache_key(prompt_key, image_hash);
+        return with_connection<std::optional<std::string>>([&](auto& redis) {
+            return redis.get(key);
+        });
+    }
+    
+    bool cache_response(uint64_t prompt_key, uint64_t image_hash, const std::string& value,
+                        int ttl_seconds) {
+        if (ttl_seconds <= 0) return false;
+        std::string key = cache_key(prompt_key, image_hash);
+        return with_connection<bool>([&](auto& redis) {
+            return redis.set(key, value, ttl_seconds);
+        });
+    }
+    
+    // Add frame metadata to stream
+    std::string add_frame_metadata(uint32_t frame_number, uint32_t source_id, 
+                                  uint32_t width, uint32_t height, const std::string& format = "NV12") {
+        return xadd_or_spill(frame_stream_, frame_metadata_fields(frame_number, source_id,
+                                                                  width, height, format), frame_trim_);
+    }
+    
+    std::future<std::string> add_frame_metadata_async(uint32_t frame_number, uint32_t source_id,
+                                                      uint32_t width, uint32_t height,
+                                                      const std::string& format = "NV12") {
+        auto fields = frame_metadata_fields(frame_number, source_id, width, height, format);
+        if (writer_) {
+            return queue_xadd(frame_stream_, fields, frame_trim_);
+        }
+        return ready_future(xadd_or_spill(frame_stream_, fields, frame_trim_));
+    }
+    
+    // Pipeline counters; all zero when pipelining is off
+    RedisPipelinedWriter::Stats get_pipeline_stats() const {
+        return writer_ ? writer_->stats() : RedisPipelinedWriter::Stats{0, 0, 0};
+    }
+    
+    // Read latest VLM results
+    // Entries reclaimed from dead consumers are returned before new ones.
+    std::vector<StreamMessage> get_latest_vlm_results(int count = 10, int block_ms = 1000) {
+        std::vector<StreamMessage> messages = take_reclaimed(count);
+        if (messages.size() >= (size_t)count) return messages;
+        
+        auto fresh = with_connection<std::vector<StreamMessage>>([&](auto& redis) {
+            return redis.xreadgroup(consumer_group_, consumer_name_, vlm_stream_,
+                                    count - (int)messages.size(), messages.empty() ? block_ms : 0);
+        });
+        messages.insert(messages.end(), std::make_move_iterator(fresh.begin()),
+                        std::make_move_iterator(fresh.end()));
+        decode_results(messages);
+        return messages;
+    }
+    
+    // Consumer name used for XREADGROUP and claims. Defaults to
+    // deepstream_vlm-<host>-<pid> so that scaled-out instances are distinct
+    // consumers and one's pending entries can be recovered by the others.
+    void set_consumer_name(const std::string& consumer_name) {
+        consumer_name_ = consumer_name;
+    }
+    
+    const std::string& get_consumer_name() const {
+        return consumer_name_;
+    }
+    
+    // Stream that receives entries given up on by pending recovery, and
+    // its own trimming (about 10000 entries by default), independent of the
+    // result stream's
+    void set_dead_letter_stream(const std::string& dead_letter_stream,
+                                const StreamTrim& trim = StreamTrim::max_length(10000)) {
+        dead_letter_stream_ = dead_letter_stream;
+        dead_letter_trim_ = trim;
+    }
+    
+    // One recovery pass over the VLM result stream's PEL: dead-letter
+    // entries delivered `max_deliveries` times, then XAUTOCLAIM the other
+    // idle ones for this consumer (unless `recovery.claim` is off), to be
+    // returned by get_latest_vlm_results(). Returns the number of entries
+    // claimed.
+    size_t recover_pending(const PendingRecovery& recovery = PendingRecovery()) {
+        uint64_t min_idle = (uint64_t)recovery.min_idle.count();
+        return with_connection<size_t>([&](auto& redis) {
+            for (const PendingEntry& entry : redis.xpending_range(vlm_stream_, consumer_group_, min_idle,
+                                                                  "-", "+", recovery.batch)) {
+                if (entry.deliveries >= recovery.max_deliveries) {
+                    dead_letter(redis, entry);
+                }
+            }
+            
+            // Leave entries in the PEL while earlier claims are unread
+            if (!recovery.claim || reclaimed_size() >= (size_t)recovery.batch) return (size_t)0;
+            
+            size_t claimed = 0;
+            std::string cursor = "0-0";
+            do {
+                AutoClaimResult result = redis.xautoclaim(vlm_stream_, consumer_group_, consumer_name_,
+                                                          min_idle, cursor, recovery.batch);
+                claimed += result.messages.size();
+                add_reclaimed(std::move(result.messages));
+                cursor = std::move(result.next_id);
+            } while (cursor != "0-0" && claimed < (size_t)recovery.batch);
+            reclaimed_total_ += claimed;
+            return claimed;
+        });
+    }
+    
+    // Run recover_pending() every `recovery.interval` in the background
+    void start_pending_recovery(const PendingRecovery& recovery = PendingRecovery()) {
+        stop_pending_recovery();
+        {
+            std::lock_guard<std::mutex> lock(recovery_mutex_);
+            recovery_stop_ = false;
+        }
+        recovery_thread_ = std::thread([this, recovery] {
+            std::unique_lock<std::mutex> lock(recovery_mutex_);
+            while (!recovery_cond_.wait_for(lock, recovery.interval, [this] { return recovery_stop_; })) {
+                lock.unlock();
+                recover_pending(recovery);
+                lock.lock();
+            }
+        });
+    }
+    
+    void stop_pending_recovery() {
+        {
+            std::lock_guard<std::mutex> lock(recovery_mutex_);
+            recovery_stop_ = true;
+        }
+        recovery_cond_.notify_all();
+        if (recovery_thread_.joinable()) {
+            recovery_thread_.join();
+        }
+    }
+    
+    struct PendingStats {
+        uint64_t pending;          // entries in the VLM group's PEL
+        size_t consumers;          // consumers holding pending entries
+        uint64_t oldest_age_ms;    // age of the oldest pending entry
+        uint64_t reclaimed;        // claimed by recover_pending() so far
+        uint64_t dead_lettered;    // moved to the dead-letter stream so far
+    };
+    
+    PendingStats get_pending_stats() {
+        PendingSummary summary = with_connection<PendingSummary>([this](auto& redis) {
+            return redis.xpending(vlm_stream_, consumer_group_);
+        });
+        uint64_t oldest = summary.min_id.empty() ? 0 : stream_id_timestamp(summary.min_id);
+        uint64_t now = get_current_timestamp();
+        return {summary.count, summary.consumers.size(), oldest && now > oldest ? now - oldest : 0,
+                reclaimed_total_.load(), dead_lettered_.load()};
+    }
+    
+    // Pending entries per consumer of the VLM group
+    PendingSummary get_pending_summary() {
+        return with_connection<PendingSummary>([this](auto& redis) {
+            return redis.xpending(vlm_stream_, consumer_group_);
+        });
+    }
+    
+    // Read VLM results in time range
+    std::vector<StreamMessage> get_vlm_results_range(uint64_t start_timestamp, uint64_t end_timestamp, int count = 100) {
+        std::string start_id = std::to_string(start_timestamp) + "-0";
+        std::string end_id = std::to_string(end_timestamp) + "-0";
+        auto messages = with_connection<std::vector<StreamMessage>>([&](auto& redis) {
+            return redis.xrange(vlm_stream_, start_id, end_id, count);
+        });
+        decode_results(messages);
+        return messages;
+    }
+    
+    // Same window as get_vlm_results_range(), as views into one reply
+    StreamReply get_vlm_results_range_view(uint64_t start_timestamp, uint64_t end_timestamp, int count = 100) {
+        std::string start_id = std::to_string(start_timestamp) + "-0";
+        std::string end_id = std::to_string(end_timestamp) + "-0";
+        return with_connection<StreamReply>([&](auto& redis) {
+            return redis.xrange_view(vlm_stream_, start_id, end_id, count);
+        });
+    }
+    
+    // Get VLM results for specific source, oldest first. With a sharded
+    // layout this is the newest `count` entries of the source's own stream
+    // (one bounded XREVRANGE). Otherwise the global stream is scanned.
+    std::vector<StreamMessage> get_vlm_results_by_source(uint32_t source_id, int count = 50) {
+        if (layout_ != StreamLayout::GLOBAL) {
+            StreamReply newest = with_connection<StreamReply>([&](auto& redis) {
+                return redis.xrevrange_view(source_stream(source_id), "+", "-", count);
+            });
+            std::vector<StreamMessage> messages;
+            messages.reserve(newest.size());
+            for (size_t i = newest.size(); i-- > 0;) {
+                messages.push_back(newest[i].to_message());
+            }
+            decode_results(messages);
+            return messages;
+        }
+        // Filter on views; only matching entries are copied out
+        StreamReply messages = with_connection<StreamReply>([&](auto& redis) {
+            return redis.xrange_view(vlm_stream_, "-", "+", count * 2);  // Get more to filter
+        });
+        
+        std::vector<StreamMessage> filtered;
+        for (const auto& msg : messages) {
+            if (entry_source_id(msg) == source_id) {
+                filtered.push_back(msg.to_message());
+                if (filtered.size() >= count) break;
+            }
+        }
+        
+        decode_results(filtered);
+        return filtered;
+    }
+    
+    // Newest `count` results across `source_ids`, oldest first. Reads at
+    // most `count` entries from each source stream with XREVRANGE and does a
+    // k-way merge by stream ID. Needs a SHARDED or BOTH layout.
+    std::vector<StreamMessage> get_vlm_results_merged(const std::vector<uint32_t>& source_ids,
+                                                      int count = 50) {
+        if (layout_ == StreamLayout::GLOBAL || count <= 0) return {};
+        
+        // In cluster mode each read goes to the node owning that source
+        std::vector<StreamReply> shards = with_connection<std::vector<StreamReply>>([&](auto& redis) {
+            std::vector<StreamReply> replies;
+            replies.reserve(source_ids.size());
+            for (uint32_t source_id : source_ids) {
+                replies.push_back(redis.xrevrange_view(source_stream(source_id), "+", "-", count));
+            }
+            return replies;
+        });
+        
+        // Max-heap on the head of each newest-first list
+        using Cursor = std::pair<size_t, size_t>;  // (shard, position)
+        auto older = [&shards](const Cursor& a, const Cursor& b) {
+            return stream_id_less(shards[a.first][a.second], shards[b.first][b.second]);
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(older)> heads(older);
+        for (size_t i = 0; i < shards.size(); i++) {
+            if (!shards[i].empty()) heads.push({i, 0});
+        }
+        
+        std::vector<StreamMessage> merged;
+        merged.reserve(count);
+        while (!heads.empty() && merged.size() < (size_t)count) {
+            Cursor head = heads.top();
+            heads.pop();
+            merged.push_back(shards[head.first][head.second].to_message());
+            if (head.second + 1 < shards[head.first].size()) {
+                heads.push({head.first, head.second + 1});
+            }
+        }
+        std::reverse(merged.begin(), merged.end());
+        decode_results(merged);
+        return merged;
+    }
+    
+    // Acknowledge processed message
+    bool ack_message(const std::string& stream, const std::string& message_id) {
+        return with_connection<bool>([&](auto& redis) {
+            return redis.xack(stream, consumer_group_, message_id);
+        });
+    }
+    
+    // Get stream statistics
+    std::map<std::string, std::string> get_vlm_stream_stats() {
+        return with_connection<std::map<std::string, std::string>>([&](auto& redis) {
+            return redis.xinfo_stream(vlm_stream_);
+        });
+    }
+    
     std::map<std::string, std::string> get_frame_stream_stats() {
-        return redis_client_.xinfo_stream(frame_stream_);
+        return with_connection<std::map<std::string, std::string>>([&](auto& redis) {
+            return redis.xinfo_stream(frame_stream_);
+        });
     }
     
-    // Set custom stream names
+    // Set custom stream names and the trimming applied by every XADD
     void configure_streams(const std::string& vlm_stream, const std::string& frame_stream, 
-                          const std::string& consumer_group = "vlm_processors") {
+                          const std::string& consumer_group = "vlm_processors",
+                          const StreamTrim& vlm_trim = StreamTrim(),
+                          const StreamTrim& frame_trim = StreamTrim()) {
         vlm_stream_ = vlm_stream;
         frame_stream_ = frame_stream;
         consumer_group_ = consumer_group;
+        vlm_trim_ = vlm_trim;
+        frame_trim_ = frame_trim;
         
         // Create new consumer groups
-        redis_client_.xgroup_create(vlm_stream_, consumer_group_, "0");
-        redis_client_.xgroup_create(frame_stream_, consumer_group_, "0");
+        with_connection<bool>([this](auto& redis) {
+            return redis.xgroup_create(vlm_stream_, consumer_group_, "0") &&
+                   redis.xgroup_create(frame_stream_, consumer_group_, "0");
+        });
+    }
+    
+    // Trimming applied by add_vlm_result / add_frame_metadata, e.g.
+    // StreamTrim::max_length(100000). Call before publishing starts.
+    void set_stream_trim(const StreamTrim& vlm_trim, const StreamTrim& frame_trim) {
+        vlm_trim_ = vlm_trim;
+        frame_trim_ = frame_trim;
+    }
+    
+    // Background XTRIM MINID ~ (now - retention) on all streams every
+    // `interval`, so entries older than `retention` are dropped even when
+    // nothing is being published. A zero retention stops the task.
+    void start_retention(std::chrono::milliseconds retention,
+                         std::chrono::milliseconds interval = std::chrono::milliseconds(60000)) {
+        stop_retention();
+        if (retention.count() <= 0) return;
+        
+        {
+            std::lock_guard<std::mutex> lock(retention_mutex_);
+            retention_stop_ = false;
+        }
+        retention_thread_ = std::thread([this, retention, interval] {
+            StreamTrim trim = StreamTrim::max_age(retention);
+            std::unique_lock<std::mutex> lock(retention_mutex_);
+            while (!retention_cond_.wait_for(lock, interval, [this] { return retention_stop_; })) {
+                lock.unlock();
+                std::vector<std::string> streams = {vlm_stream_, frame_stream_, partial_stream_};
+                for (uint32_t source_id : known_sources()) {
+                    streams.push_back(source_stream(source_id));
+                }
+                with_connection<bool>([&](auto& redis) {
+                    for (const auto& stream : streams) {
+                        long long removed = redis.xtrim(stream, trim);
+                        if (removed > 0) retention_trimmed_ += removed;
+                    }
+                    return true;
+                });
+                lock.lock();
+            }
+        });
+    }
+    
+    void stop_retention() {
+        {
+            std::lock_guard<std::mutex> lock(retention_mutex_);
+            retention_stop_ = true;
+        }
+        retention_cond_.notify_all();
+        if (retention_thread_.joinable()) {
+            retention_thread_.join();
+        }
+    }
+    
+    // Entries removed by the retention task so far
+    uint64_t get_retention_trimmed() const {
+        return retention_trimmed_.load();
+    }
+    
+    ~VLMRedisStreamManager() {
+        stop_replay();
+        stop_pending_recovery();
+        stop_retention();
     }
     
     bool is_connected() const {
-        return redis_client_.is_connected();
+        return cluster_ ? cluster_->is_connected() : pool_->is_connected();
+    }
+    
+    // All zero in cluster mode, which keeps its pools per master
+    RedisConnectionPool::Stats get_pool_stats() const {
+        return pool_ ? pool_->stats() : RedisConnectionPool::Stats{0, 0, 0, 0, 0};
+    }
+    
+    // Redirect and topology counters; all zero outside cluster mode
+    RedisClusterClient::Stats get_cluster_stats() const {
+        return cluster_ ? cluster_->stats() : RedisClusterClient::Stats{0, 0, 0, 0, 0};
     }
 
 private:
-    RedisClient redis_client_;
+    std::unique_ptr<RedisConnectionPool> pool_;     // null in cluster mode
+    std::unique_ptr<RedisClusterClient> cluster_;   // set in cluster mode, replaces pool_
+    std::mutex spill_id_mutex_;                     // also used by writer_'s spill handler
+    uint64_t spill_id_ms_ = 0;
+    uint64_t spill_id_seq_ = 0;
+    std::unique_ptr<RedisSpillLog> spill_;          // outlives writer_, which spills into it
+    std::unique_ptr<RedisPipelinedWriter> writer_;
+    std::string redis_host_;
+    int redis_port_;
+    RedisConnectionOptions options_;
     std::string vlm_stream_;
     std::string frame_stream_;
     std::string consumer_group_;
     std::string consumer_name_;
+    std::string dead_letter_stream_ = "vlm:results:deadletter";
+    StreamTrim dead_letter_trim_ = StreamTrim::max_length(10000);
+    std::string partial_stream_ = "vlm:results:partial";
+    StreamTrim partial_trim_ = StreamTrim::max_length(10000);
+    std::string cache_prefix_ = "vlm:cache:";
+    StreamTrim vlm_trim_;
+    StreamTrim frame_trim_;
+    StreamLayout layout_ = StreamLayout::GLOBAL;
+    std::string source_stream_prefix_ = "vlm:results:";
+    
+    std::unique_ptr<VLMResultCodec> codec_;     // set when VLM results use the compact encoding
+    std::string model_table_ = "vlm:models";   // hash: model id -> model name
+    std::mutex models_mutex_;
+    std::unordered_map<uint32_t, std::string> models_;
+    std::unordered_set<uint32_t> registered_models_;
+    std::mutex sources_mutex_;
+    std::unordered_set<uint32_t> sources_;   // sources with a per-source stream
+    
+    std::thread retention_thread_;
+    std::mutex retention_mutex_;
+    std::condition_variable retention_cond_;
+    bool retention_stop_ = false;
+    std::atomic<uint64_t> retention_trimmed_{0};
+    
+    std::thread recovery_thread_;
+    std::mutex recovery_mutex_;
+    std::condition_variable recovery_cond_;
+    bool recovery_stop_ = false;
+    std::mutex reclaimed_mutex_;
+    std::deque<StreamMessage> reclaimed_;    // claimed, not yet returned to the reader
+    std::atomic<uint64_t> reclaimed_total_{0};
+    std::atomic<uint64_t> dead_lettered_{0};
+    
+    std::thread replay_thread_;
+    std::mutex replay_mutex_;
+    std::condition_variable replay_cond_;
+    bool replay_stop_ = false;
     
     uint64_t get_current_timestamp() const {
         return std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
     }
+    
+    std::map<std::string, std::string> vlm_result_fields(uint32_t frame_number, uint32_t source_id,
+                                                         const std::string& vlm_response,
+                                                         const std::string& model_name,
+                                                         bool cached) {
+        std::map<std::string, std::string> fields;
+        if (codec_) {
+            fields[VLMResultCodec::kField] =
+                codec_->encode(frame_number, source_id, intern_model(model_name), vlm_response);
+        } else {
+            fields = {
+                {"frame_number", std::to_string(frame_number)},
+                {"source_id", std::to_string(source_id)},
+                {"vlm_response", vlm_response},
+                {"model_name", model_name},
+                {"timestamp", std::to_string(get_current_timestamp())},
+                {"type", "vlm_result"}
+            };
+        }
+        // A field of its own in both layouts; decode_compact keeps it
+        if (cached) fields["cached"] = "1";
+        return fields;
+    }
+    
+    std::string cache_key(uint64_t prompt_key, uint64_t image_hash) const {
+        char hex[34];
+        snprintf(hex, sizeof(hex), "%016llx:%016llx", (unsigned long long)prompt_key,
+                 (unsigned long long)image_hash);
+        return cache_prefix_ + hex;
+    }
+    
+    std::map<std::string, std::string> vlm_partial_fields(uint32_t frame_number, uint32_t source_id,
+                                                          const std::string& vlm_response,
+                                                          const std::string& model_name,
+                                                          uint64_t tokens) const {
+        return {
+            {"frame_number", std::to_string(frame_number)},
+            {"source_id", std::to_string(source_id)},
+            {"vlm_response", vlm_response},
+            {"model_name", model_name},
+            {"tokens", std::to_string(tokens)},
+            {"timestamp", std::to_string(get_current_timestamp())},
+            {"type", "vlm_partial"}
+        };
+    }
+    
+    std::map<std::string, std::string> frame_metadata_fields(uint32_t frame_number, uint32_t source_id,
+                                                             uint32_t width, uint32_t height,
+                                                             const std::string& format) const {
+        return {
+            {"frame_number", std::to_string(frame_number)},
+            {"source_id", std::to_string(source_id)},
+            {"width", std::to_string(width)},
+            {"height", std::to_string(height)},
+            {"format", format},
+            {"timestamp", std::to_string(get_current_timestamp())},
+            {"type", "frame_metadata"}
+        };
+    }
+    
+    // Id of `model_name` in compact entries. Registered in the model table
+    // on first use, and again on later uses while that keeps failing.
+    uint32_t intern_model(const std::string& model_name) {
+        uint32_t id = vlm_model_id(model_name);
+        {
+            std::lock_guard<std::mutex> lock(models_mutex_);
+            if (registered_models_.count(id)) return id;
+        }
+        bool registered = with_connection<bool>([&](auto& redis) {
+            return redis.hset(model_table_, std::to_string(id), model_name);
+        });
+        std::lock_guard<std::mutex> lock(models_mutex_);
+        models_[id] = model_name;
+        if (registered) registered_models_.insert(id);
+        return id;
+    }
+    
+    // Expand compact entries in place. The model table is read back from
+    // Redis (once per call) when an entry names a model not seen yet, e.g.
+    // one written by another process.
+    void decode_results(std::vector<StreamMessage>& messages) {
+        std::unordered_map<uint32_t, std::string> models;
+        bool copied = false, reloaded = false;
+        for (StreamMessage& message : messages) {
+            auto it = message.fields.find(VLMResultCodec::kField);
+            if (it == message.fields.end()) continue;
+            if (!copied) {
+                std::lock_guard<std::mutex> lock(models_mutex_);
+                models = models_;
+                copied = true;
+            }
+            VLMResultRecord record;
+            if (!reloaded && VLMResultCodec::decode(it->second, record, false) &&
+                models.count(record.model_id) == 0) {
+                models = load_models();
+                reloaded = true;
+            }
+            message.decode_compact(models);
+        }
+    }
+    
+    std::unordered_map<uint32_t, std::string> load_models() {
+        auto table = with_connection<std::map<std::string, std::string>>([&](auto& redis) {
+            return redis.hgetall(model_table_);
+        });
+        std::lock_guard<std::mutex> lock(models_mutex_);
+        for (const auto& [key, name] : table) {
+            uint32_t id;
+            if (std::from_chars(key.data(), key.data() + key.size(), id).ec == std::errc()) {
+                models_[id] = name;
+            }
+        }
+        return models_;
+    }
+    
+    // source_id of a plain or compact entry, without decoding the response
+    static uint32_t entry_source_id(const StreamMessageView& message) {
+        std::string_view compact = message.get_field(VLMResultCodec::kField);
+        VLMResultRecord record;
+        if (!compact.empty() && VLMResultCodec::decode(compact, record, false)) {
+            return record.source_id;
+        }
+        return message.get_field_as<uint32_t>("source_id");
+    }
+    
+    // Run fn(redis) on a pooled RedisClient, or on the cluster client in
+    // cluster mode; both expose the same stream methods. R() when no
+    // connection could be had.
+    template <typename R, typename Fn>
+    R with_connection(Fn&& fn) {
+        if (cluster_) {
+            return fn(*cluster_);
+        }
+        auto redis = pool_->checkout();
+        if (!redis) return R();
+        return fn(*redis);
+    }
+    
+    // Blocking XADD(s) according to the layout
+    std::string publish_vlm_result(uint32_t source_id, const std::map<std::string, std::string>& fields) {
+        std::string message_id;
+        if (layout_ != StreamLayout::SHARDED) {
+            message_id = xadd_or_spill(vlm_stream_, fields, vlm_trim_);
+        }
+        if (layout_ != StreamLayout::GLOBAL) {
+            note_source(source_id);
+            std::string shard_id = xadd_or_spill(source_stream(source_id), fields, vlm_trim_);
+            if (layout_ == StreamLayout::SHARDED) {
+                message_id = std::move(shard_id);
+            }
+        }
+        return message_id;
+    }
+    
+    // Blocking XADD. With a spill log it is spilled instead when Redis
+    // cannot be reached, or when older spilled entries are still waiting.
+    std::string xadd_or_spill(const std::string& stream, const std::map<std::string, std::string>& fields,
+                              const StreamTrim& trim) {
+        if (!spill_) {
+            return with_connection<std::string>([&](auto& redis) {
+                return redis.xadd(stream, fields, trim);
+            });
+        }
+        if (spill_->pending() == 0) {
+            auto redis = pool_->checkout();
+            if (redis) {
+                std::string message_id = redis->xadd(stream, fields, trim);
+                if (!message_id.empty() || redis->healthy()) {
+                    return message_id;  // written, or rejected by Redis itself
+                }
+            }
+        }
+        return spill_xadd(stream, fields, trim);
+    }
+    
+    // Pipelined XADD, spilled while older spilled entries are waiting
+    std::future<std::string> queue_xadd(const std::string& stream,
+                                        const std::map<std::string, std::string>& fields,
+                                        const StreamTrim& trim) {
+        if (spill_ && spill_->pending() > 0) {
+            return ready_future(spill_xadd(stream, fields, trim));
+        }
+        return writer_->xadd(stream, fields, trim);
+    }
+    
+    std::string spill_xadd(const std::string& stream, const std::map<std::string, std::string>& fields,
+                           const StreamTrim& trim) {
+        RedisCommandArgs args;
+        args.add("XADD").add(stream).add(trim).add(spill_id());
+        for (const auto& [key, value] : fields) {
+            args.add(key).add(value);
+        }
+        spill_->append(args.size(), args.argv(), args.lens());
+        return "";
+    }
+    
+    // The writer spills its XADDs as queued, with "*"; they get an ID too
+    void hook_writer_spill() {
+        writer_->set_spill_handler([this](size_t argc, const char** argv, const size_t* argvlen) {
+            size_t at = xadd_id_index(argc, argv, argvlen);
+            if (at == 0) {
+                return spill_->append(argc, argv, argvlen);
+            }
+            std::vector<const char*> args(argv, argv + argc);
+            std::vector<size_t> lens(argvlen, argvlen + argc);
+            std::string id = spill_id();
+            args[at] = id.data();
+            lens[at] = id.size();
+            return spill_->append(argc, args.data(), lens.data());
+        });
+    }
+    
+    // Explicit XADD ID for an entry being spilled: now, strictly increasing
+    // across the log
+    std::string spill_id() {
+        std::lock_guard<std::mutex> lock(spill_id_mutex_);
+        uint64_t now = get_current_timestamp();
+        if (now > spill_id_ms_) {
+            spill_id_ms_ = now;
+            spill_id_seq_ = 0;
+        } else {
+            spill_id_seq_++;
+        }
+        return std::to_string(spill_id_ms_) + "-" + std::to_string(spill_id_seq_);
+    }
+    
+    // Index of the ID in an XADD [MAXLEN|MINID [~|=] n [LIMIT n]] command,
+    // 0 if it is some other command
+    static size_t xadd_id_index(size_t argc, const char* const* argv, const size_t* lens) {
+        auto is = [&](size_t i, std::string_view arg) {
+            return i < argc && std::string_view(argv[i], lens[i]) == arg;
+        };
+        if (!is(0, "XADD")) return 0;
+        size_t i = 2;
+        if (is(i, "MAXLEN") || is(i, "MINID")) {
+            i += (is(i + 1, "~") || is(i + 1, "=")) ? 3 : 2;
+            if (is(i, "LIMIT")) i += 2;
+        }
+        return i < argc ? i : 0;
+    }
+    
+    // Sends a batch read back from the spill log. XADDs rejected because
+    // their ID is not above the stream's last entry are sent again with "*"
+    // in a second round trip. Returns how many commands, from the start of
+    // the batch, are known to have been applied.
+    static size_t replay_batch(RedisClient& redis, const RedisSpillLog::Batch& batch) {
+        std::vector<size_t> rejected;
+        size_t replies = redis.pipeline_argv(batch.size(), batch.argc.data(),
+                                             const_cast<const char**>(batch.argv.data()), batch.lens.data(),
+                                             [&rejected](size_t i, redisReply* reply) {
+            if (reply && reply->type == REDIS_REPLY_ERROR &&
+                std::string_view(reply->str, reply->len).find("equal or smaller") != std::string_view::npos) {
+                rejected.push_back(i);
+            }
+        });
+        if (rejected.empty()) return replies;
+        
+        std::vector<size_t> first(batch.size());   // index of each command's first argument
+        for (size_t i = 1; i < batch.size(); i++) {
+            first[i] = first[i - 1] + batch.argc[i - 1];
+        }
+        std::vector<size_t> argc;
+        std::vector<const char*> argv;
+        std::vector<size_t> lens;
+        for (size_t i : rejected) {
+            const char* const* cmd = batch.argv.data() + first[i];
+            const size_t* cmd_lens = batch.lens.data() + first[i];
+            size_t at = xadd_id_index(batch.argc[i], cmd, cmd_lens);
+            argc.push_back(batch.argc[i]);
+            for (size_t k = 0; k < batch.argc[i]; k++) {
+                argv.push_back(k == at ? "*" : cmd[k]);
+                lens.push_back(k == at ? 1 : cmd_lens[k]);
+            }
+        }
+        size_t resent = redis.pipeline_argv(argc.size(), argc.data(), argv.data(), lens.data());
+        return resent < rejected.size() ? std::min(replies, rejected[resent]) : replies;
+    }
+    
+    // Replays the spill log whenever a connection can be had; polls every
+    // 100 ms while there is a backlog (reconnects themselves back off).
+    void replay_loop() {
+        std::unique_lock<std::mutex> lock(replay_mutex_);
+        while (!replay_cond_.wait_for(lock, std::chrono::milliseconds(100), [this] { return replay_stop_; })) {
+            if (spill_->pending() == 0) continue;
+            lock.unlock();
+            if (auto redis = pool_->checkout()) {
+                size_t replayed = 0, sent;
+                do {
+                    sent = spill_->replay([&redis](const RedisSpillLog::Batch& batch) {
+                        return replay_batch(*redis, batch);
+                    });
+                    replayed += sent;
+                } while (sent > 0 && !replay_stopping());
+                if (replayed > 0) {
+                    std::cout << "Redis spill log: replayed " << replayed << " commands, "
+                              << spill_->pending() << " left" << std::endl;
+                }
+            }
+            lock.lock();
+        }
+    }
+    
+    bool replay_stopping() {
+        std::lock_guard<std::mutex> lock(replay_mutex_);
+        return replay_stop_;
+    }
+    
+    void stop_replay() {
+        {
+            std::lock_guard<std::mutex> lock(replay_mutex_);
+            replay_stop_ = true;
+        }
+        replay_cond_.notify_all();
+        if (replay_thread_.joinable()) {
+            replay_thread_.join();
+        }
+    }
+    
+    // Copy a pending entry to the dead-letter stream with where it came
+    // from, then acknowledge it. An entry deleted from the stream (e.g. by
+    // trimming) is acknowledged without a copy.
+    template <typename Redis>
+    void dead_letter(Redis& redis, const PendingEntry& entry) {
+        std::vector<StreamMessage> original = redis.xrange(vlm_stream_, entry.id, entry.id, 1);
+        if (!original.empty()) {
+            std::map<std::string, std::string> fields = std::move(original.front().fields);
+            fields["dead_letter_stream"] = vlm_stream_;
+            fields["dead_letter_id"] = entry.id;
+            fields["dead_letter_consumer"] = entry.consumer;
+            fields["dead_letter_deliveries"] = std::to_string(entry.deliveries);
+            if (redis.xadd(dead_letter_stream_, fields, dead_letter_trim_).empty()) {
+                return;  // keep it pending, retried on the next pass
+            }
+        }
+        if (redis.xack(vlm_stream_, consumer_group_, entry.id)) {
+            dead_lettered_++;
+        }
+    }
+    
+    void add_reclaimed(std::vector<StreamMessage> messages) {
+        std::lock_guard<std::mutex> lock(reclaimed_mutex_);
+        for (auto& msg : messages) {
+            reclaimed_.push_back(std::move(msg));
+        }
+    }
+    
+    size_t reclaimed_size() {
+        std::lock_guard<std::mutex> lock(reclaimed_mutex_);
+        return reclaimed_.size();
+    }
+    
+    std::vector<StreamMessage> take_reclaimed(int count) {
+        std::lock_guard<std::mutex> lock(reclaimed_mutex_);
+        std::vector<StreamMessage> messages;
+        while (!reclaimed_.empty() && messages.size() < (size_t)count) {
+            messages.push_back(std::move(reclaimed_.front()));
+            reclaimed_.pop_front();
+        }
+        return messages;
+    }
+    
+    static std::string default_consumer_name() {
+        char host[256] = "";
+        gethostname(host, sizeof(host) - 1);
+        return std::string("deepstream_vlm-") + host + "-" + std::to_string(getpid());
+    }
+    
+    void note_source(uint32_t source_id) {
+        std::lock_guard<std::mutex> lock(sources_mutex_);
+        sources_.insert(source_id);
+    }
+    
+    std::vector<uint32_t> known_sources() {
+        std::lock_guard<std::mutex> lock(sources_mutex_);
+        return std::vector<uint32_t>(sources_.begin(), sources_.end());
+    }
+    
+    static std::future<std::string> ready_future(std::string value) {
+        std::promise<std::string> promise;
+        promise.set_value(std::move(value));
+        return promise.get_future();
+    }
 };
 
 #endif // REDIS_CLIENT_H
@@ -555,10 +3446,41 @@ USAGE EXAMPLES:
        vlm_stream.ack_message("vlm:results:stream", msg.id);
    }
 
+   // Elsewhere, recover entries left pending by consumers that died:
+   vlm_stream.start_pending_recovery();   // claim after 60s idle, dead-letter after 5 deliveries
+   // (the dsexample element, which only publishes, dead-letters with
+   // redis-pending-recovery-sec and claim = false)
+   auto pel = vlm_stream.get_pending_stats();
+
 3. Historical queries:
    uint64_t hour_ago = get_timestamp() - 3600000;
    auto historical = vlm_stream.get_vlm_results_range(hour_ago, get_timestamp());
 
+4. Redis Cluster (seed node; per-source streams spread by hash tag):
+   VLMRedisStreamManager vlm_stream("127.0.0.1", 7000, 4, true);
+   vlm_stream.set_stream_layout(StreamLayout::SHARDED);
+   vlm_stream.add_vlm_result(123, 5, "Car on highway");   // -> vlm:results:{5}
+
+5. Compact entries (one MessagePack "vlm" field; build with WITH_ZSTD=1 for zstd):
+   vlm_stream.enable_compact_encoding(VLMCompression::ZSTD, 512);
+   vlm_stream.add_vlm_result(123, 0, long_caption, "vila");   // model name interned in vlm:models
+   // get_latest_vlm_results() etc. return the usual fields; other readers
+   // decode with VLMResultCodec::decode() and HGETALL vlm:models
+
+6. Analytics scans (views into the reply, no per-entry maps, no exceptions):
+   StreamReply history = vlm_stream.get_vlm_results_range_view(hour_ago, get_timestamp(), 100000);
+   StreamSchema schema{"frame_number", "source_id"};
+   std::vector<uint32_t> frames = schema.extract<uint32_t>(history, 0);   // column 0
+   std::optional<uint32_t> source = schema.get_as<uint32_t>(history[0], 1);
+
+LOCAL CLUSTER FOR TESTING (three masters, no replicas):
+   for p in 7000 7001 7002; do
+     mkdir -p /tmp/rc/$p && (cd /tmp/rc/$p && redis-server --port $p --cluster-enabled yes \
+       --cluster-config-file nodes.conf --appendonly no --daemonize yes)
+   done
+   redis-cli --cluster create 127.0.0.1:7000 127.0.0.1:7001 127.0.0.1:7002 --cluster-replicas 0 --cluster-yes
+   # Exercise MOVED: redis-cli --cluster reshard 127.0.0.1:7000 while publishing
+
 REDIS CLI COMMANDS:
 
 # Monitor stream in real-time
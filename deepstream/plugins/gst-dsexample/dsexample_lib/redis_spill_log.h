@@ -0,0 +1,356 @@
+// RedisSpillLog.h - On-disk write-ahead log for Redis commands that could not be sent
+#ifndef REDIS_SPILL_LOG_H
+#define REDIS_SPILL_LOG_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Bounded, append-only log of commands (argv form) kept in mmap'd segment
+// files under one directory.
+//
+// append() copies a command into the newest segment, opening another one
+// when it is full. Once `max_segments` are in use new commands are
+// refused and counted as dropped, so the oldest entries are always the
+// ones kept. replay() hands the oldest commands to a sender in batches and
+// advances a read offset stored in the segment header only past the ones
+// the sender reports delivered; fully replayed segments are deleted.
+// Segments are shared mappings, so a log that survives a crash (of the
+// process, not the machine) is picked up and replayed by the next
+// RedisSpillLog opened on the same directory.
+//
+// Record layout, 8-byte aligned:
+//   u32 payload length, u32 FNV-1a of payload,
+//   payload = u32 argc, argc x u32 arg length, argument bytes
+// A zero length ends the segment; a checksum mismatch (torn write) too.
+class RedisSpillLog {
+public:
+    // Commands handed to the sender: argc[i] arguments each, the arguments
+    // of all commands back to back in argv/lens. Views into the log, valid
+    // for the duration of the send call.
+    struct Batch {
+        std::vector<size_t> argc;
+        std::vector<const char*> argv;
+        std::vector<size_t> lens;
+
+        size_t size() const { return argc.size(); }
+        void clear() {
+            argc.clear();
+            argv.clear();
+            lens.clear();
+        }
+    };
+
+    struct Stats {
+        size_t segments;     // segment files on disk
+        uint64_t pending;    // commands waiting to be replayed
+        uint64_t spilled;    // commands appended so far
+        uint64_t replayed;   // commands delivered by replay()
+        uint64_t dropped;    // commands refused because the log was full
+    };
+
+    RedisSpillLog(const std::string& dir, size_t segment_bytes = 8 << 20, size_t max_segments = 16)
+        : dir_(dir), segment_bytes_(std::max<size_t>(segment_bytes, 4096)),
+          max_segments_(max_segments < 1 ? 1 : max_segments), next_seq_(0),
+          pending_(0), spilled_(0), replayed_(0), dropped_(0) {
+        mkdir(dir_.c_str(), 0755);
+        recover();
+    }
+
+    ~RedisSpillLog() {
+        for (auto& segment : segments_) {
+            unmap(segment);
+        }
+    }
+
+    RedisSpillLog(const RedisSpillLog&) = delete;
+    RedisSpillLog& operator=(const RedisSpillLog&) = delete;
+
+    // Append one command. False if it was dropped (log full, too large for
+    // a segment, or the segment file could not be created).
+    bool append(size_t argc, const char* const* argv, const size_t* lens) {
+        size_t payload = 4 + 4 * argc;
+        for (size_t i = 0; i < argc; i++) {
+            payload += lens[i];
+        }
+        size_t record = align(kRecordHeader + payload);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (segments_.empty() || segments_.back().write_offset + record > segments_.back().size) {
+            if (kHeaderSize + record > segment_bytes_ || segments_.size() >= max_segments_ ||
+                !open_segment(next_seq_++, true)) {
+                dropped_++;
+                return false;
+            }
+        }
+
+        Segment& segment = segments_.back();
+        char* out = segment.base + segment.write_offset;
+        char* p = out + kRecordHeader;
+        put32(p, (uint32_t)argc);
+        p += 4;
+        for (size_t i = 0; i < argc; i++) {
+            put32(p, (uint32_t)lens[i]);
+            p += 4;
+        }
+        for (size_t i = 0; i < argc; i++) {
+            memcpy(p, argv[i], lens[i]);
+            p += lens[i];
+        }
+        // Length last, so a torn record reads as the end of the segment
+        put32(out + 4, fnv1a(out + kRecordHeader, payload));
+        put32(out, (uint32_t)payload);
+        segment.write_offset += record;
+        pending_++;
+        spilled_++;
+        return true;
+    }
+
+    // Replay up to `max_batch` of the oldest commands through
+    // send(const Batch&), which returns how many of them, in order, were
+    // delivered. Returns that number; 0 when empty or nothing got through.
+    // Fully replayed segments are deleted on the way, so a call that
+    // reaches the end of one segment carries on with the next.
+    // One replay at a time; appends may run concurrently.
+    template <typename Send>
+    size_t replay(Send&& send, size_t max_batch = 256) {
+        std::lock_guard<std::mutex> replay_lock(replay_mutex_);
+
+        std::vector<size_t> ends;   // offset after each collected record
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (segments_.empty()) return 0;
+                collect(segments_.front(), max_batch, ends);
+            }
+            if (batch_.size() > 0) break;
+            // Front segment fully replayed: go on with the next one
+            if (!drop_replayed_segment()) return 0;
+        }
+
+        size_t delivered = std::min(send(static_cast<const Batch&>(batch_)), batch_.size());
+        batch_.clear();
+
+        if (delivered > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            set_read_offset(segments_.front(), ends[delivered - 1]);
+            pending_ -= delivered;
+            replayed_ += delivered;
+        }
+        drop_replayed_segment();
+        return delivered;
+    }
+
+    uint64_t pending() const {
+        return pending_.load();
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {segments_.size(), pending_.load(), spilled_.load(), replayed_.load(), dropped_.load()};
+    }
+
+private:
+    static constexpr size_t kHeaderSize = 64;
+    static constexpr size_t kRecordHeader = 8;
+    static constexpr char kMagic[8] = {'V', 'L', 'M', 'S', 'P', 'I', 'L', 'L'};
+
+    // Segment header: magic, u32 version, u32 reserved, u64 read offset
+    struct Segment {
+        uint64_t seq;
+        std::string path;
+        char* base;
+        size_t size;
+        size_t write_offset;
+    };
+
+    static size_t align(size_t n) { return (n + 7) & ~(size_t)7; }
+
+    static void put32(char* p, uint32_t v) { memcpy(p, &v, 4); }
+    static uint32_t get32(const char* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+
+    static uint32_t fnv1a(const char* data, size_t len) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ (unsigned char)data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    static size_t read_offset(const Segment& segment) {
+        uint64_t offset;
+        memcpy(&offset, segment.base + 16, 8);
+        return (size_t)offset;
+    }
+
+    static void set_read_offset(Segment& segment, size_t offset) {
+        uint64_t value = offset;
+        memcpy(segment.base + 16, &value, 8);
+    }
+
+    std::string segment_path(uint64_t seq) const {
+        char name[40];
+        snprintf(name, sizeof(name), "spill-%020llu.seg", (unsigned long long)seq);
+        return dir_ + "/" + name;
+    }
+
+    // Map segment `seq`, creating (and sizing) the file if `create`.
+    // Caller holds mutex_.
+    bool open_segment(uint64_t seq, bool create) {
+        Segment segment{seq, segment_path(seq), nullptr, 0, kHeaderSize};
+        int fd = open(segment.path.c_str(), O_RDWR | (create ? O_CREAT | O_EXCL : 0), 0644);
+        if (fd < 0) {
+            std::cerr << "Redis spill log: cannot open " << segment.path << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        struct stat st;
+        if (create && ftruncate(fd, (off_t)segment_bytes_) != 0) {
+            std::cerr << "Redis spill log: cannot size " << segment.path << ": " << strerror(errno) << std::endl;
+            close(fd);
+            unlink(segment.path.c_str());
+            return false;
+        }
+        segment.size = create ? segment_bytes_ : (fstat(fd, &st) == 0 ? (size_t)st.st_size : 0);
+        if (segment.size < kHeaderSize) {
+            close(fd);
+            return false;
+        }
+        void* base = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            std::cerr << "Redis spill log: cannot map " << segment.path << ": " << strerror(errno) << std::endl;
+            if (create) unlink(segment.path.c_str());
+            return false;
+        }
+        segment.base = (char*)base;
+
+        if (create) {
+            memcpy(segment.base, kMagic, 8);
+            put32(segment.base + 8, 1);
+            set_read_offset(segment, kHeaderSize);
+        } else if (memcmp(segment.base, kMagic, 8) != 0) {
+            munmap(segment.base, segment.size);
+            return false;
+        }
+        segments_.push_back(segment);
+        return true;
+    }
+
+    void unmap(Segment& segment) {
+        if (segment.base) {
+            msync(segment.base, segment.size, MS_ASYNC);
+            munmap(segment.base, segment.size);
+            segment.base = nullptr;
+        }
+    }
+
+    // Reopen segments left by an earlier run, oldest first, and count what
+    // they still hold. Appends continue in the newest one.
+    void recover() {
+        std::vector<uint64_t> seqs;
+        if (DIR* dir = opendir(dir_.c_str())) {
+            while (struct dirent* entry = readdir(dir)) {
+                unsigned long long seq;
+                char tail;
+                if (sscanf(entry->d_name, "spill-%20llu.se%c", &seq, &tail) == 2 && tail == 'g') {
+                    seqs.push_back(seq);
+                }
+            }
+            closedir(dir);
+        }
+        std::sort(seqs.begin(), seqs.end());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint64_t seq : seqs) {
+            if (!open_segment(seq, false)) continue;
+            Segment& segment = segments_.back();
+            size_t offset = kHeaderSize;
+            while (size_t next = next_record(segment, offset)) {
+                if (offset >= read_offset(segment)) pending_++;
+                offset = next;
+            }
+            segment.write_offset = offset;
+            next_seq_ = seq + 1;
+        }
+        if (pending_ > 0) {
+            std::cout << "Redis spill log: " << pending_ << " commands to replay from " << dir_ << std::endl;
+        }
+    }
+
+    // Offset after the valid record at `offset`, 0 at the end of the data
+    size_t next_record(const Segment& segment, size_t offset) const {
+        if (offset + kRecordHeader > segment.size) return 0;
+        uint32_t payload = get32(segment.base + offset);
+        if (payload == 0 || offset + kRecordHeader + payload > segment.size) return 0;
+        if (fnv1a(segment.base + offset + kRecordHeader, payload) != get32(segment.base + offset + 4)) return 0;
+        return offset + align(kRecordHeader + payload);
+    }
+
+    // Fill batch_ from the segment's read offset. Caller holds mutex_.
+    void collect(const Segment& segment, size_t max_batch, std::vector<size_t>& ends) {
+        size_t offset = read_offset(segment);
+        while (batch_.size() < max_batch && offset < segment.write_offset) {
+            const char* p = segment.base + offset + kRecordHeader;
+            size_t argc = get32(p);
+            const char* lens = p + 4;
+            const char* data = lens + 4 * argc;
+            for (size_t i = 0; i < argc; i++) {
+                size_t len = get32(lens + 4 * i);
+                batch_.argv.push_back(data);
+                batch_.lens.push_back(len);
+                data += len;
+            }
+            batch_.argc.push_back(argc);
+            offset += align(kRecordHeader + get32(segment.base + offset));
+            ends.push_back(offset);
+        }
+    }
+
+    // Delete the oldest segment once it is fully replayed, unless appends
+    // are still going into it. True if it was deleted.
+    bool drop_replayed_segment() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (segments_.size() < 2) return false;
+        Segment& segment = segments_.front();
+        if (read_offset(segment) < segment.write_offset) return false;
+        unmap(segment);
+        unlink(segment.path.c_str());
+        segments_.pop_front();
+        return true;
+    }
+
+    const std::string dir_;
+    const size_t segment_bytes_;
+    const size_t max_segments_;
+
+    mutable std::mutex mutex_;
+    std::deque<Segment> segments_;   // oldest first; appends go to the back
+    uint64_t next_seq_;
+
+    std::mutex replay_mutex_;
+    Batch batch_;                    // guarded by replay_mutex_
+
+    std::atomic<uint64_t> pending_;
+    std::atomic<uint64_t> spilled_;
+    std::atomic<uint64_t> replayed_;
+    std::atomic<uint64_t> dropped_;
+};
+
+#endif // REDIS_SPILL_LOG_H
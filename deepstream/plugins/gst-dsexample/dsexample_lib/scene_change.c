@@ -0,0 +1,180 @@
+#include "scene_change.h"
+
+// Pixels averaged per thumbnail pixel are at most this many across and
+// down, spread evenly over its block of the frame
+#define SCENE_BLOCK_SAMPLES 4
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+void
+SceneThumbnailFromRGB (SceneThumbnail * thumb, const unsigned char *pixels,
+    int width, int height, int stride, int channels)
+{
+    int tx, ty, x, y;
+
+    for (ty = 0; ty < SCENE_THUMB_HEIGHT; ty++)
+    {
+        // Block of frame rows covered by this thumbnail row, at least one
+        int y0 = ty * height / SCENE_THUMB_HEIGHT;
+        int y1 = (ty + 1) * height / SCENE_THUMB_HEIGHT;
+        if (y1 <= y0)
+            y1 = y0 + 1;
+
+        int ystep = (y1 - y0 + SCENE_BLOCK_SAMPLES - 1) / SCENE_BLOCK_SAMPLES;
+
+        for (tx = 0; tx < SCENE_THUMB_WIDTH; tx++)
+        {
+            int x0 = tx * width / SCENE_THUMB_WIDTH;
+            int x1 = (tx + 1) * width / SCENE_THUMB_WIDTH;
+            int xstep;
+            unsigned long sum = 0, count = 0;
+            if (x1 <= x0)
+                x1 = x0 + 1;
+            xstep = (x1 - x0 + SCENE_BLOCK_SAMPLES - 1) / SCENE_BLOCK_SAMPLES;
+
+            for (y = y0; y < y1; y += ystep)
+            {
+                const unsigned char *row = pixels + (size_t) y * stride;
+                for (x = x0; x < x1; x += xstep, count++)
+                {
+                    const unsigned char *p = row + (size_t) x * channels;
+                    // BT.601: Y = 0.299 R + 0.587 G + 0.114 B, scaled by 256
+                    sum += 77u * p[0] + 150u * p[1] + 29u * p[2];
+                }
+            }
+            thumb->luma[ty * SCENE_THUMB_WIDTH + tx] =
+                (unsigned char) (sum / (count * 256));
+        }
+    }
+}
+
+double
+SceneThumbnailDifference (const SceneThumbnail * a, const SceneThumbnail * b)
+{
+    return (double) SceneSAD (a->luma, b->luma, SCENE_THUMB_PIXELS)
+        / SCENE_THUMB_PIXELS;
+}
+
+unsigned long long
+SceneThumbnailDHash (const SceneThumbnail * thumb)
+{
+    unsigned int grid[8][9];
+    unsigned long long hash = 0;
+    int gx, gy, x, y;
+
+    for (gy = 0; gy < 8; gy++)
+    {
+        int y0 = gy * SCENE_THUMB_HEIGHT / 8;
+        int y1 = (gy + 1) * SCENE_THUMB_HEIGHT / 8;
+        for (gx = 0; gx < 9; gx++)
+        {
+            int x0 = gx * SCENE_THUMB_WIDTH / 9;
+            int x1 = (gx + 1) * SCENE_THUMB_WIDTH / 9;
+            unsigned int sum = 0;
+            for (y = y0; y < y1; y++)
+                for (x = x0; x < x1; x++)
+                    sum += thumb->luma[y * SCENE_THUMB_WIDTH + x];
+            // Blocks differ in width by a pixel; compare means, not sums
+            grid[gy][gx] = sum * 64 / ((x1 - x0) * (y1 - y0));
+        }
+    }
+    for (gy = 0; gy < 8; gy++)
+        for (gx = 0; gx < 8; gx++)
+            hash = (hash << 1) | (grid[gy][gx] > grid[gy][gx + 1]);
+    return hash;
+}
+
+int
+SceneHashDistance (unsigned long long a, unsigned long long b)
+{
+    return __builtin_popcountll (a ^ b);
+}
+
+unsigned long
+SceneSADScalar (const unsigned char *a, const unsigned char *b, size_t n)
+{
+    unsigned long sum = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+    return sum;
+}
+
+#if defined(__SSE2__)
+
+unsigned long
+SceneSAD (const unsigned char *a, const unsigned char *b, size_t n)
+{
+    // PSADBW sums 8 absolute differences into each 64-bit half
+    __m128i acc = _mm_setzero_si128 ();
+    unsigned long long halves[2];
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i va = _mm_loadu_si128 ((const __m128i *) (a + i));
+        __m128i vb = _mm_loadu_si128 ((const __m128i *) (b + i));
+        acc = _mm_add_epi64 (acc, _mm_sad_epu8 (va, vb));
+    }
+    _mm_storeu_si128 ((__m128i *) halves, acc);
+    return (unsigned long) (halves[0] + halves[1])
+        + SceneSADScalar (a + i, b + i, n - i);
+}
+
+const char *
+SceneSADKernel (void)
+{
+    return "sse2";
+}
+
+#elif defined(__ARM_NEON)
+
+unsigned long
+SceneSAD (const unsigned char *a, const unsigned char *b, size_t n)
+{
+    uint32x4_t acc = vdupq_n_u32 (0);
+    size_t i = 0;
+
+    while (i + 16 <= n)
+    {
+        // Each block adds up to 2 * 255 to a 16-bit lane: widen every 128
+        uint16x8_t partial = vdupq_n_u16 (0);
+        size_t end = n - i > 128 * 16 ? i + 128 * 16 : n;
+        for (; i + 16 <= end; i += 16)
+        {
+            uint8x16_t diff = vabdq_u8 (vld1q_u8 (a + i), vld1q_u8 (b + i));
+            partial = vpadalq_u8 (partial, diff);
+        }
+        acc = vpadalq_u16 (acc, partial);
+    }
+    return (unsigned long) vgetq_lane_u32 (acc, 0) + vgetq_lane_u32 (acc, 1)
+        + vgetq_lane_u32 (acc, 2) + vgetq_lane_u32 (acc, 3)
+        + SceneSADScalar (a + i, b + i, n - i);
+}
+
+const char *
+SceneSADKernel (void)
+{
+    return "neon";
+}
+
+#else
+
+unsigned long
+SceneSAD (const unsigned char *a, const unsigned char *b, size_t n)
+{
+    return SceneSADScalar (a, b, n);
+}
+
+const char *
+SceneSADKernel (void)
+{
+    return "scalar";
+}
+
+#endif
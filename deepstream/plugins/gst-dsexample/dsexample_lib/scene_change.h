@@ -0,0 +1,54 @@
+#ifndef __SCENE_CHANGE_H__
+#define __SCENE_CHANGE_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Thumbnail resolution, independent of the frame's aspect ratio
+#define SCENE_THUMB_WIDTH 64
+#define SCENE_THUMB_HEIGHT 64
+#define SCENE_THUMB_PIXELS (SCENE_THUMB_WIDTH * SCENE_THUMB_HEIGHT)
+
+// Downscaled luma of a frame, compared against the thumbnail of the last
+// frame sent to the VLM to tell whether the scene has changed
+typedef struct
+{
+  unsigned char luma[SCENE_THUMB_PIXELS];
+} SceneThumbnail;
+
+// Fill `thumb` with the BT.601 luma of an RGB (channels = 3) or RGBA (4)
+// frame, each thumbnail pixel the average of up to 4x4 pixels spread over
+// its block of the frame. `stride` is the frame's row pitch in bytes.
+// Frames smaller than the thumbnail are upsampled by repetition.
+void SceneThumbnailFromRGB (SceneThumbnail *thumb, const unsigned char *pixels,
+    int width, int height, int stride, int channels);
+
+// Mean absolute luma difference of two thumbnails, 0 (identical) to 255
+double SceneThumbnailDifference (const SceneThumbnail *a, const SceneThumbnail *b);
+
+// 64-bit difference hash (dHash) of a thumbnail: the thumbnail averaged
+// down to 9x8, one bit per horizontally adjacent pair set when the left
+// one is brighter. Near-identical frames hash to values a few bits apart.
+unsigned long long SceneThumbnailDHash (const SceneThumbnail *thumb);
+
+// Number of differing bits of two hashes, 0 to 64
+int SceneHashDistance (unsigned long long a, unsigned long long b);
+
+// Sum of absolute differences of two byte arrays, vectorised where the
+// target has SSE2 or NEON
+unsigned long SceneSAD (const unsigned char *a, const unsigned char *b, size_t n);
+
+// Portable SceneSAD, for targets without either and for comparison
+unsigned long SceneSADScalar (const unsigned char *a, const unsigned char *b, size_t n);
+
+// Kernel SceneSAD was built with: "sse2", "neon" or "scalar"
+const char *SceneSADKernel (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
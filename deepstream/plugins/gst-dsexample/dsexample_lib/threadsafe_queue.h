@@ -2,11 +2,14 @@
 #ifndef THREAD_SAFE_QUEUE_H_
 #define THREAD_SAFE_QUEUE_H_
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
 template <typename T>
 class ThreadSafeQueue {
@@ -20,6 +23,21 @@ class ThreadSafeQueue {
     cond_.notify_one();
   }
 
+  // Single lock acquisition for the bounded case: drops the oldest entries
+  // until there is room. Returns the number of entries dropped.
+  size_t push_bounded(T new_value, size_t max_size) {
+    auto data = std::make_shared<T>(std::move(new_value));
+    size_t dropped = 0;
+    std::lock_guard<std::mutex> lock(m_);
+    while (max_size > 0 && data_queue_.size() >= max_size) {
+      data_queue_.pop();
+      ++dropped;
+    }
+    data_queue_.push(data);
+    cond_.notify_one();
+    return dropped;
+  }
+
   void share_push(std::shared_ptr<T> data) {
     std::lock_guard<std::mutex> lock(m_);
     data_queue_.push(data);
@@ -83,7 +101,41 @@ class ThreadSafeQueue {
     return res;
   }
 
+  // Micro-batching pop: blocks until the first item arrives, then keeps
+  // collecting until `max_items` are available or `max_wait` has elapsed
+  // since that first item. Returns whatever was collected (empty once the
+  // queue is terminated).
+  template <typename Rep, typename Period>
+  std::vector<std::shared_ptr<T>> pop_batch(size_t max_items,
+      std::chrono::duration<Rep, Period> max_wait) {
+    std::vector<std::shared_ptr<T>> batch;
+    if (max_items == 0) {
+      return batch;
+    }
+
+    std::unique_lock<std::mutex> lock(m_);
+    cond_.wait(lock, [this] {
+      return !data_queue_.empty() || is_terminated_;
+    });
+    if (is_terminated_) {
+      return batch;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + max_wait;
+    cond_.wait_until(lock, deadline, [this, max_items] {
+      return data_queue_.size() >= max_items || is_terminated_;
+    });
+
+    batch.reserve(std::min(max_items, data_queue_.size()));
+    while (!data_queue_.empty() && batch.size() < max_items) {
+      batch.push_back(data_queue_.front());
+      data_queue_.pop();
+    }
+    return batch;
+  }
+
   void terminate() {
+    std::lock_guard<std::mutex> lock(m_);
     is_terminated_ = true;
     cond_.notify_all();
   }
@@ -0,0 +1,305 @@
+
+#ifndef VLM_DISPATCHER_H_
+#define VLM_DISPATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fair_frame_queue.h"
+#include "redis_client.h"
+#include "vlm_http_client.h"
+#include "vlm_result_publisher.h"
+
+struct VLMDispatcherConfig {
+  size_t workers = 4;             // Shared worker threads
+  size_t queue_size = 256;        // Frames queued across all clients
+  size_t max_per_source = 10;     // Per-source cap in the shared queue
+  size_t redis_connections = 2;   // Pooled connections shared by the workers
+  size_t redis_pipeline_size = 0; // XADD pipeline batch per manager, 0 = off
+  std::chrono::microseconds redis_pipeline_flush{500};
+  uint64_t redis_stream_maxlen = 0;          // XADD MAXLEN ~ cap, 0 = unbounded
+  std::chrono::milliseconds redis_retention{0};  // background XTRIM age, 0 = off
+  std::chrono::milliseconds redis_pending_idle{0};  // dead-letter idle PEL entries, 0 = off
+  StreamLayout redis_stream_layout = StreamLayout::GLOBAL;
+  bool redis_cluster = false;   // redis_host:redis_port is a cluster seed node
+  std::string redis_spill_dir;  // on-disk spill log while Redis is down, "" = off
+  size_t redis_spill_max_bytes = 128 << 20;
+  bool redis_compact = false;   // one MessagePack field per VLM result
+  VLMCompression redis_compression = VLMCompression::NONE;
+  size_t redis_compress_min_bytes = 512;
+  std::string redis_host = "localhost";
+  int redis_port = 6379;
+  RedisConnectionOptions redis_options;   // Unix socket, timeouts, keepalive
+  VLMHttpClientConfig http;     // One backend client for every element
+  // Writes a batch of results on the publisher thread and returns how many
+  // failed. Shared by all elements, so it must not refer to any one of them.
+  std::function<size_t(VLMRedisStreamManager *redis,
+                       std::vector<VLMPublishItem> &batch)> publish_results;
+};
+
+// Process-wide VLM dispatcher shared by every dsexample instance.
+//
+// In demux mode there is one element per camera. Instead of each element
+// owning a worker thread and a Redis connection, elements register as
+// clients and submit frames here. One fair queue (keyed by source_id) feeds
+// a fixed pool of workers. Handlers send requests with submit_request() on
+// one HTTP client, whose vlm-max-inflight limit is therefore shared, and
+// queue results on one publisher writing through one stream manager backed
+// by a small connection pool. Threads and sockets scale with configured
+// capacity rather than with the number of cameras.
+//
+// acquire() returns the singleton, creating it with the given config on
+// first use; it is destroyed when the last reference goes away.
+template <typename T>
+class VLMDispatcher {
+ public:
+  // Runs on a dispatcher worker. Returns false on failure.
+  using Handler = std::function<bool(const T &frame)>;
+
+  class Client {
+   public:
+    explicit Client(Handler handler) : handler_(std::move(handler)) {}
+
+   private:
+    friend class VLMDispatcher;
+
+    void hold() {
+      std::lock_guard<std::mutex> lock(m_);
+      ++inflight_;
+    }
+
+    void release() {
+      std::lock_guard<std::mutex> lock(m_);
+      if (--inflight_ == 0) {
+        idle_.notify_all();
+      }
+    }
+
+    Handler handler_;
+    std::atomic<bool> active_{true};
+    std::mutex m_{};
+    std::condition_variable idle_{};
+    size_t inflight_ = 0;   // Handler calls and backend requests
+  };
+
+  struct Stats {
+    uint64_t requests;
+    uint64_t failures;
+    uint64_t dropped;
+    size_t clients;
+  };
+
+  static std::shared_ptr<VLMDispatcher> acquire(const VLMDispatcherConfig &config) {
+    static std::mutex instance_mutex;
+    static std::weak_ptr<VLMDispatcher> instance;
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    std::shared_ptr<VLMDispatcher> dispatcher = instance.lock();
+    if (!dispatcher) {
+      dispatcher.reset(new VLMDispatcher(config));
+      instance = dispatcher;
+    }
+    return dispatcher;
+  }
+
+  ~VLMDispatcher() {
+    queue_.terminate();
+    for (auto &worker : workers_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+    // Every client has been unregistered, so no request is outstanding;
+    // results still queued get as long as a request would have had
+    VLMHttpClient::Stats http = http_->stats();
+    http_.reset();
+    if (publisher_ && !publisher_->stop(request_timeout_)) {
+      std::cerr << "VLM dispatcher dropped results Redis did not take in time"
+                << std::endl;
+    }
+    std::cout << "VLM dispatcher stopped: requests=" << requests_
+              << " failures=" << failures_ << " dropped=" << dropped_
+              << "; HTTP requests=" << http.requests << " failures=" << http.failures
+              << " connections=" << http.connects << std::endl;
+  }
+
+  std::shared_ptr<Client> register_client(Handler handler) {
+    clients_.fetch_add(1, std::memory_order_relaxed);
+    return std::make_shared<Client>(std::move(handler));
+  }
+
+  // Stops delivering to `client` and waits for its in-flight calls and
+  // backend requests to finish. Frames it still has queued are discarded
+  // when dequeued; results it has queued are still published.
+  void unregister_client(const std::shared_ptr<Client> &client) {
+    if (!client || !client->active_.exchange(false)) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(client->m_);
+    client->idle_.wait(lock, [&client] { return client->inflight_ == 0; });
+    clients_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Never blocks. Returns the number of queued frames evicted.
+  size_t submit(const std::shared_ptr<Client> &client, T frame) {
+    Job job;
+    job.source_id = frame.source_id;
+    job.client = client;
+    job.frame = std::move(frame);
+    size_t evicted = queue_.push_drop_oldest(std::move(job));
+    dropped_.fetch_add(evicted, std::memory_order_relaxed);
+    return evicted;
+  }
+
+  // Sends `body` on the shared HTTP client for `client`, waiting first
+  // while max_inflight requests of any client are outstanding.
+  // unregister_client() waits for `done` too. False, with neither callback
+  // run, when the client is shutting down.
+  bool submit_request(const std::shared_ptr<Client> &client, std::string body,
+                      VLMHttpClient::Callback done,
+                      VLMHttpClient::PartialCallback partial = nullptr) {
+    client->hold();
+    bool ok = http_->submit(
+        std::move(body),
+        [client, done = std::move(done)](VLMHttpResult result) {
+          done(std::move(result));
+          client->release();
+        },
+        std::move(partial));
+    if (!ok) {
+      client->release();
+    }
+    return ok;
+  }
+
+  VLMHttpClient &http_client() { return *http_; }
+
+  // Null when Redis is disabled
+  VLMResultPublisher *publisher() { return publisher_.get(); }
+
+  // Runs fn(VLMRedisStreamManager *) on the shared stream manager, whose
+  // calls each check a connection out of its pool. Returns false without
+  // calling fn when Redis is disabled.
+  template <typename Fn>
+  bool with_redis(Fn &&fn) {
+    if (!redis_) {
+      return false;
+    }
+    return fn(redis_.get());
+  }
+
+  size_t queue_size() const {
+    return queue_.size();
+  }
+
+  Stats stats() const {
+    return {requests_.load(), failures_.load(), dropped_.load(), clients_.load()};
+  }
+
+ private:
+  struct Job {
+    uint32_t source_id = 0;
+    std::shared_ptr<Client> client;
+    T frame{};
+  };
+
+  explicit VLMDispatcher(const VLMDispatcherConfig &config)
+      : queue_(config.queue_size, config.max_per_source),
+        request_timeout_(config.http.request_timeout) {
+    if (config.redis_connections > 0) {
+      redis_.reset(new VLMRedisStreamManager(config.redis_host,
+                                             config.redis_port,
+                                             config.redis_connections,
+                                             config.redis_cluster,
+                                             config.redis_options));
+      redis_->enable_pipelining(config.redis_pipeline_size,
+                                config.redis_pipeline_flush);
+      if (config.redis_stream_maxlen > 0) {
+        StreamTrim trim = StreamTrim::max_length(config.redis_stream_maxlen);
+        redis_->set_stream_trim(trim, trim);
+      }
+      redis_->set_stream_layout(config.redis_stream_layout);
+      redis_->start_retention(config.redis_retention);
+      if (config.redis_pending_idle.count() > 0) {
+        PendingRecovery recovery;
+        recovery.min_idle = config.redis_pending_idle;
+        recovery.claim = false;   // Results are published, never read, here
+        redis_->start_pending_recovery(recovery);
+      }
+      if (!config.redis_spill_dir.empty()) {
+        redis_->enable_spill(config.redis_spill_dir,
+                             config.redis_spill_max_bytes);
+      }
+      if (config.redis_compact) {
+        redis_->enable_compact_encoding(config.redis_compression,
+                                        config.redis_compress_min_bytes);
+      }
+      if (config.publish_results) {
+        auto publish_results = config.publish_results;
+        publisher_.reset(new VLMResultPublisher(
+            [this, publish_results](std::vector<VLMPublishItem> &batch) {
+              return publish_results(redis_.get(), batch);
+            }));
+      }
+    }
+    http_.reset(new VLMHttpClient(config.http));
+    for (size_t i = 0; i < (config.workers < 1 ? 1 : config.workers); ++i) {
+      workers_.emplace_back(&VLMDispatcher::worker_loop, this);
+    }
+    std::cout << "✅ VLM dispatcher started: " << workers_.size() << " workers, "
+              << http_->config().max_inflight << " requests in flight, "
+              << config.redis_connections << " Redis connections" << std::endl;
+  }
+
+  void worker_loop() {
+    Job job;
+    while (queue_.wait_and_pop(job)) {
+      std::shared_ptr<Client> client = std::move(job.client);
+      {
+        std::lock_guard<std::mutex> lock(client->m_);
+        if (!client->active_) {
+          job.frame = T{};
+          continue;  // element already stopped
+        }
+        ++client->inflight_;
+      }
+
+      bool ok = false;
+      try {
+        ok = client->handler_(job.frame);
+      } catch (const std::exception &e) {
+        std::cerr << "VLM dispatcher handler error: " << e.what() << std::endl;
+      }
+
+      requests_.fetch_add(1, std::memory_order_relaxed);
+      if (!ok) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+      }
+      job.frame = T{};  // release pooled buffers before the client may go away
+      client->release();
+    }
+  }
+
+  FairFrameQueue<Job> queue_;
+  std::vector<std::thread> workers_{};
+  std::chrono::milliseconds request_timeout_;
+  // Destroyed in reverse: the publisher writes through redis_
+  std::unique_ptr<VLMRedisStreamManager> redis_{};
+  std::unique_ptr<VLMResultPublisher> publisher_{};
+  std::unique_ptr<VLMHttpClient> http_{};
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> failures_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<size_t> clients_{0};
+};
+
+#endif //VLM_DISPATCHER_H_
@@ -0,0 +1,183 @@
+
+#ifndef VLM_FRAME_QUEUE_H_
+#define VLM_FRAME_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "threadsafe_queue.h"
+#include "mpmc_ring_buffer.h"
+
+// Bounded queue between the streaming thread (producer) and the VLM
+// worker(s) (consumers). Producers never block: when the queue is full the
+// oldest entry is dropped. Implementations differ in how they store and
+// order entries.
+template <typename T>
+class VLMFrameQueue {
+ public:
+  virtual ~VLMFrameQueue() = default;
+
+  // Enqueue, evicting the oldest entry when full. Returns the number of
+  // entries evicted.
+  virtual size_t push_drop_oldest(T value) = 0;
+
+  // Block until an entry is available. Returns false once terminated.
+  virtual bool wait_and_pop(T &value) = 0;
+
+  // Block until the first entry is available, then collect up to
+  // `max_items` entries, waiting at most `max_wait` after the first one.
+  // Entries are appended to `batch`; returns how many were appended
+  // (0 once terminated).
+  virtual size_t pop_batch(std::vector<T> &batch, size_t max_items,
+      std::chrono::milliseconds max_wait) = 0;
+
+  virtual size_t size() const = 0;
+
+  virtual void terminate() = 0;
+};
+
+// The original mutex + condition variable queue, with the size check,
+// drop-oldest and push folded into a single lock acquisition.
+template <typename T>
+class MutexFrameQueue : public VLMFrameQueue<T> {
+ public:
+  explicit MutexFrameQueue(size_t max_size) : max_size_(max_size) {}
+
+  size_t push_drop_oldest(T value) override {
+    return queue_.push_bounded(std::move(value), max_size_);
+  }
+
+  bool wait_and_pop(T &value) override {
+    auto data = queue_.wait_and_pop();
+    if (!data) {
+      return false;
+    }
+    value = std::move(*data);
+    return true;
+  }
+
+  size_t pop_batch(std::vector<T> &batch, size_t max_items,
+      std::chrono::milliseconds max_wait) override {
+    auto items = queue_.pop_batch(max_items, max_wait);
+    for (auto &item : items) {
+      batch.push_back(std::move(*item));
+    }
+    return items.size();
+  }
+
+  size_t size() const override {
+    return queue_.size();
+  }
+
+  void terminate() override {
+    queue_.terminate();
+  }
+
+ private:
+  const size_t max_size_;
+  ThreadSafeQueue<T> queue_{};
+};
+
+// Lock-free ring on the producer side. Consumers only touch the mutex when
+// the ring is empty and they have to sleep; producers only take it to wake
+// a sleeping consumer.
+template <typename T>
+class LockFreeFrameQueue : public VLMFrameQueue<T> {
+ public:
+  explicit LockFreeFrameQueue(size_t max_size) : ring_(max_size) {}
+
+  size_t push_drop_oldest(T value) override {
+    size_t evicted = ring_.push_evict_oldest(std::move(value));
+    wake_one();
+    return evicted;
+  }
+
+  bool wait_and_pop(T &value) override {
+    if (ring_.try_pop(value)) {
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock(m_);
+    for (;;) {
+      if (is_terminated_) {
+        return false;
+      }
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      // Re-check after announcing ourselves: a producer that pushed before
+      // seeing sleepers_ != 0 is guaranteed to be visible here.
+      bool popped = ring_.try_pop(value);
+      if (!popped && !is_terminated_) {
+        cond_.wait_for(lock, std::chrono::milliseconds(100));
+        popped = ring_.try_pop(value);
+      }
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      if (popped) {
+        return true;
+      }
+    }
+  }
+
+  size_t pop_batch(std::vector<T> &batch, size_t max_items,
+      std::chrono::milliseconds max_wait) override {
+    if (max_items == 0) {
+      return 0;
+    }
+    T value;
+    if (!wait_and_pop(value)) {
+      return 0;
+    }
+    batch.push_back(std::move(value));
+    size_t count = 1;
+
+    auto deadline = std::chrono::steady_clock::now() + max_wait;
+    while (count < max_items) {
+      if (ring_.try_pop(value)) {
+        batch.push_back(std::move(value));
+        ++count;
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_);
+      if (is_terminated_ || std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
+      sleepers_.fetch_add(1, std::memory_order_seq_cst);
+      if (ring_.empty()) {
+        cond_.wait_until(lock, deadline);
+      }
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  size_t size() const override {
+    return ring_.size();
+  }
+
+  void terminate() override {
+    std::lock_guard<std::mutex> lock(m_);
+    is_terminated_ = true;
+    cond_.notify_all();
+  }
+
+ private:
+  void wake_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(m_);
+      cond_.notify_one();
+    }
+  }
+
+  MpmcRingBuffer<T> ring_;
+  std::mutex m_{};
+  std::condition_variable cond_{};
+  std::atomic<int> sleepers_{0};
+  std::atomic<bool> is_terminated_{false};
+};
+
+#endif //VLM_FRAME_QUEUE_H_
@@ -0,0 +1,627 @@
+#ifndef VLM_HTTP_CLIENT_H_
+#define VLM_HTTP_CLIENT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+#include <nlohmann/json.hpp>
+
+struct VLMHttpClientConfig {
+  // Full chat/completions endpoint of an OpenAI-compatible server
+  // (vLLM, SGLang, Ollama's /v1, ...)
+  std::string url = "http://localhost:8000/v1/chat/completions";
+  std::string model;              // "" leaves the choice to the server
+  std::string prompt = "Describe what is happening in this image.";
+  std::string api_key;            // Sent as a Bearer token when set
+  int max_tokens = 256;
+  std::chrono::milliseconds request_timeout{30000};  // Whole request, queueing included
+  std::chrono::milliseconds connect_timeout{5000};
+  size_t max_inflight = 32;       // submit() blocks while this many are outstanding
+  size_t max_connections = 0;     // Per host, 0 = max_inflight
+
+  // Ask for a server-sent event stream ("stream": true) and hand the text
+  // generated so far to the request's partial callback every
+  // stream_flush_tokens tokens, or on the first token after
+  // stream_flush_interval without a flush.
+  bool stream = false;
+  size_t stream_flush_tokens = 8;
+  std::chrono::milliseconds stream_flush_interval{250};
+};
+
+struct VLMHttpResult {
+  bool ok = false;
+  long status = 0;                // HTTP status, 0 if no response arrived
+  std::string content;            // choices[0].message.content when ok
+  std::string model;              // Model that answered, as reported by the server
+  std::string error;              // Reason when not ok
+  std::chrono::microseconds latency{0};
+  std::chrono::microseconds first_token{0};  // Streamed requests, 0 if none arrived
+  size_t tokens = 0;              // Streamed content deltas received
+};
+
+// Standard base64 (RFC 4648) with padding
+inline std::string vlm_base64_encode(const uint8_t *data, size_t len) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  out.resize((len + 2) / 3 * 4);
+  char *dst = &out[0];
+  size_t i = 0;
+  for (; i + 2 < len; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16 | (uint32_t)data[i + 1] << 8 | data[i + 2];
+    *dst++ = kAlphabet[v >> 18];
+    *dst++ = kAlphabet[(v >> 12) & 63];
+    *dst++ = kAlphabet[(v >> 6) & 63];
+    *dst++ = kAlphabet[v & 63];
+  }
+  if (i < len) {
+    uint32_t v = (uint32_t)data[i] << 16 | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0);
+    *dst++ = kAlphabet[v >> 18];
+    *dst++ = kAlphabet[(v >> 12) & 63];
+    *dst++ = i + 1 < len ? kAlphabet[(v >> 6) & 63] : '=';
+    *dst++ = '=';
+  }
+  return out;
+}
+
+// 24-bit uncompressed BMP of tightly packed RGB (3 channels) or RGBA (4,
+// alpha dropped) pixels. Needs no codec library, at the price of a large
+// request; encode JPEG instead where one is available.
+inline std::string vlm_encode_bmp(const uint8_t *pixels, uint32_t width,
+                                  uint32_t height, uint32_t channels) {
+  const uint32_t row_size = (width * 3 + 3) & ~3u;
+  const uint32_t image_size = row_size * height;
+  std::string bmp(54 + image_size, '\0');
+  auto put32 = [&bmp](size_t at, uint32_t v) {
+    for (int i = 0; i < 4; ++i) bmp[at + i] = (char)(v >> (8 * i));
+  };
+  bmp[0] = 'B';
+  bmp[1] = 'M';
+  put32(2, 54 + image_size);
+  put32(10, 54);                  // Pixel data offset
+  put32(14, 40);                  // BITMAPINFOHEADER
+  put32(18, width);
+  put32(22, height);              // Positive: rows stored bottom-up
+  bmp[26] = 1;                    // Planes
+  bmp[28] = 24;                   // Bits per pixel
+  put32(34, image_size);
+
+  uint8_t *dst = (uint8_t *)&bmp[54];
+  for (uint32_t y = 0; y < height; ++y) {
+    const uint8_t *src = pixels + (size_t)(height - 1 - y) * width * channels;
+    uint8_t *row = dst + (size_t)y * row_size;
+    for (uint32_t x = 0; x < width; ++x, src += channels) {
+      row[3 * x] = src[2];        // BMP stores BGR
+      row[3 * x + 1] = src[1];
+      row[3 * x + 2] = src[0];
+    }
+  }
+  return bmp;
+}
+
+inline std::string vlm_image_data_uri(std::string_view mime_type,
+                                      std::string_view image) {
+  return "data:" + std::string(mime_type) + ";base64," +
+         vlm_base64_encode((const uint8_t *)image.data(), image.size());
+}
+
+// Incremental parser of a text/event-stream body (the server-sent events
+// wire format). feed() takes the body in arbitrary chunks and calls
+// on_data with the data of each complete event: its "data:" lines joined
+// by '\n'. Comments and other fields are skipped; lines may end in LF or
+// CRLF. A final event left without its blank line is delivered by finish().
+class VLMSseParser {
+ public:
+  template <typename OnData>
+  void feed(const char *data, size_t len, OnData &&on_data) {
+    buffer_.append(data, len);
+    size_t pos = 0;
+    size_t eol;
+    while ((eol = buffer_.find('\n', pos)) != std::string::npos) {
+      std::string_view line(buffer_.data() + pos, eol - pos);
+      pos = eol + 1;
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (line.empty()) {
+        dispatch(on_data);
+      } else if (line.substr(0, 5) == "data:") {
+        line.remove_prefix(5);
+        if (!line.empty() && line.front() == ' ') {
+          line.remove_prefix(1);
+        }
+        if (has_data_) {
+          data_ += '\n';
+        }
+        data_.append(line.data(), line.size());
+        has_data_ = true;
+      }
+    }
+    buffer_.erase(0, pos);
+  }
+
+  template <typename OnData>
+  void finish(OnData &&on_data) {
+    if (!buffer_.empty()) {
+      feed("\n", 1, on_data);
+    }
+    dispatch(on_data);
+  }
+
+  void reset() {
+    buffer_.clear();
+    data_.clear();
+    has_data_ = false;
+  }
+
+ private:
+  template <typename OnData>
+  void dispatch(OnData &on_data) {
+    if (has_data_) {
+      on_data(std::string_view(data_));
+    }
+    data_.clear();
+    has_data_ = false;
+  }
+
+  std::string buffer_;            // Unterminated line carried to the next chunk
+  std::string data_;              // Data of the event being assembled
+  bool has_data_ = false;
+};
+
+// OpenAI-compatible chat/completions client that keeps many requests in
+// flight from any number of threads.
+//
+// submit() hands a request body to one I/O thread that drives every
+// transfer through a libcurl multi handle, so a single caller can have
+// dozens of requests outstanding without a thread each. Connections stay
+// open between requests (HTTP/1.1 keep-alive, or multiplexed HTTP/2 when
+// the server offers it) and are capped per host. Each request has its own
+// timeout. submit() blocks while max_inflight requests are outstanding,
+// which pushes back on the caller's frame queue instead of piling up
+// requests the server cannot serve.
+//
+// With config.stream the reply is read as server-sent events while it is
+// generated: choices[0].delta.content of each chunk is accumulated, and the
+// request's partial callback sees the text so far as it grows. The done
+// callback still gets the whole content once the stream ends. A server that
+// ignores "stream" and answers with one JSON body is handled as usual.
+//
+// Completion and partial callbacks run on the I/O thread: keep them short.
+// Requests still outstanding at destruction complete with "cancelled".
+class VLMHttpClient {
+ public:
+  using Callback = std::function<void(VLMHttpResult result)>;
+  // Text generated so far, the number of tokens it took and the model
+  // reported by the server ("" if none)
+  using PartialCallback = std::function<void(const std::string &text, size_t tokens,
+                                             const std::string &model)>;
+
+  struct Stats {
+    uint64_t requests;      // Completed, successfully or not
+    uint64_t failures;
+    uint64_t timeouts;      // Subset of failures
+    uint64_t connects;      // New connections opened; well below requests when reused
+    uint64_t partials;      // Partial callbacks run for streamed requests
+    size_t inflight;
+  };
+
+  explicit VLMHttpClient(VLMHttpClientConfig config) : config_(std::move(config)) {
+    static std::once_flag curl_init;
+    std::call_once(curl_init, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    if (config_.max_inflight < 1) {
+      config_.max_inflight = 1;
+    }
+    long connections = (long)(config_.max_connections > 0 ? config_.max_connections
+                                                          : config_.max_inflight);
+    multi_ = curl_multi_init();
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, connections);
+    curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS, connections);
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    headers_ = curl_slist_append(headers_, "Content-Type: application/json");
+    headers_ = curl_slist_append(headers_, "Expect:");  // No 100-continue round trip
+    if (!config_.api_key.empty()) {
+      headers_ = curl_slist_append(
+          headers_, ("Authorization: Bearer " + config_.api_key).c_str());
+    }
+    io_thread_ = std::thread(&VLMHttpClient::io_loop, this);
+  }
+
+  ~VLMHttpClient() {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      stopping_ = true;
+    }
+    slot_free_.notify_all();
+    curl_multi_wakeup(multi_);
+    if (io_thread_.joinable()) {
+      io_thread_.join();
+    }
+    for (CURL *easy : idle_) {
+      curl_easy_cleanup(easy);
+    }
+    curl_multi_cleanup(multi_);
+    curl_slist_free_all(headers_);
+  }
+
+  VLMHttpClient(const VLMHttpClient &) = delete;
+  VLMHttpClient &operator=(const VLMHttpClient &) = delete;
+
+  const VLMHttpClientConfig &config() const { return config_; }
+
+  // Request body asking config().prompt about one image, given as a data
+  // URI (see vlm_image_data_uri) or an http(s) URL. Base64 needs no JSON
+  // escaping, so a data URI is appended as is rather than copied through
+  // a json value.
+  std::string build_request(std::string_view image_url) const {
+    nlohmann::json text = {{"type", "text"}, {"text", config_.prompt}};
+    std::string body = R"({"messages":[{"role":"user","content":[)";
+    body.reserve(body.size() + image_url.size() + config_.prompt.size() + 256);
+    body += text.dump();
+    body += R"(,{"type":"image_url","image_url":{"url":)";
+    if (image_url.substr(0, 5) == "data:") {
+      body += '"';
+      body += image_url;
+      body += '"';
+    } else {
+      body += nlohmann::json(std::string(image_url)).dump();
+    }
+    body += R"(}}]}],"max_tokens":)";
+    body += std::to_string(config_.max_tokens);
+    if (!config_.model.empty()) {
+      body += R"(,"model":)";
+      body += nlohmann::json(config_.model).dump();
+    }
+    if (config_.stream) {
+      body += R"(,"stream":true)";
+    }
+    body += '}';
+    return body;
+  }
+
+  // Queues `body` for POSTing, waiting first while max_inflight requests
+  // are outstanding. `done` runs exactly once, on the I/O thread, after
+  // any calls of `partial` (streamed replies only). Returns false without
+  // calling either once the client is shutting down.
+  bool submit(std::string body, Callback done, PartialCallback partial = nullptr) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->body = std::move(body);
+    transfer->done = std::move(done);
+    transfer->partial = std::move(partial);
+    {
+      std::unique_lock<std::mutex> lock(m_);
+      slot_free_.wait(lock, [this] {
+        return stopping_ || inflight_ < config_.max_inflight;
+      });
+      if (stopping_) {
+        return false;
+      }
+      ++inflight_;
+      pending_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_);
+    return true;
+  }
+
+  std::future<VLMHttpResult> submit(std::string body) {
+    auto promise = std::make_shared<std::promise<VLMHttpResult>>();
+    std::future<VLMHttpResult> result = promise->get_future();
+    if (!submit(std::move(body), [promise](VLMHttpResult r) {
+          promise->set_value(std::move(r));
+        })) {
+      VLMHttpResult cancelled;
+      cancelled.error = "cancelled";
+      promise->set_value(std::move(cancelled));
+    }
+    return result;
+  }
+
+  // Waits up to `timeout` for outstanding requests to complete; true if
+  // none are left. New submissions are not held off meanwhile.
+  bool drain(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_);
+    return slot_free_.wait_for(lock, timeout, [this] { return inflight_ == 0; });
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return {requests_.load(), failures_.load(), timeouts_.load(), connects_.load(),
+            partials_.load(), inflight_};
+  }
+
+ private:
+  struct Transfer {
+    VLMHttpClient *client = nullptr;
+    CURL *easy = nullptr;
+    std::string body;
+    std::string response;         // Whole body, unless it is an event stream
+    Callback done;
+    PartialCallback partial;
+    std::chrono::steady_clock::time_point start;
+
+    // Event-stream replies only
+    enum class Body { UNKNOWN, PLAIN, EVENTS } kind = Body::UNKNOWN;
+    VLMSseParser sse;
+    std::string content;
+    std::string model;
+    std::string error;            // From an error event
+    size_t tokens = 0;
+    size_t flushed_tokens = 0;
+    bool finished = false;        // [DONE] seen
+    std::chrono::steady_clock::time_point first_token{};
+    std::chrono::steady_clock::time_point last_flush{};
+  };
+
+  static size_t write_body(char *data, size_t size, size_t nmemb, void *user) {
+    Transfer *t = static_cast<Transfer *>(user);
+    if (t->kind == Transfer::Body::UNKNOWN) {
+      // Headers are complete by the first body byte
+      long status = 0;
+      const char *type = nullptr;
+      curl_easy_getinfo(t->easy, CURLINFO_RESPONSE_CODE, &status);
+      curl_easy_getinfo(t->easy, CURLINFO_CONTENT_TYPE, &type);
+      t->kind = status == 200 && type && strncmp(type, "text/event-stream", 17) == 0
+                    ? Transfer::Body::EVENTS
+                    : Transfer::Body::PLAIN;
+    }
+    if (t->kind == Transfer::Body::PLAIN) {
+      t->response.append(data, size * nmemb);
+    } else {
+      t->sse.feed(data, size * nmemb, [t](std::string_view event) {
+        t->client->on_event(t, event);
+      });
+    }
+    return size * nmemb;
+  }
+
+  // Reused easy handles keep their per-handle caches; connections live in
+  // the multi handle's pool and are shared by all of them
+  CURL *acquire_easy() {
+    if (!idle_.empty()) {
+      CURL *easy = idle_.back();
+      idle_.pop_back();
+      return easy;
+    }
+    CURL *easy = curl_easy_init();
+    curl_easy_setopt(easy, CURLOPT_URL, config_.url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers_);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, &VLMHttpClient::write_body);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, (long)config_.request_timeout.count());
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, (long)config_.connect_timeout.count());
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+    return easy;
+  }
+
+  void start(std::unique_ptr<Transfer> transfer) {
+    Transfer *t = transfer.get();
+    t->client = this;
+    t->easy = acquire_easy();
+    t->start = std::chrono::steady_clock::now();
+    curl_easy_setopt(t->easy, CURLOPT_POSTFIELDS, t->body.data());
+    curl_easy_setopt(t->easy, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)t->body.size());
+    curl_easy_setopt(t->easy, CURLOPT_WRITEDATA, t);
+    curl_easy_setopt(t->easy, CURLOPT_PRIVATE, t);
+    curl_multi_add_handle(multi_, t->easy);
+    active_.push_back(std::move(transfer));
+  }
+
+  void finish(Transfer *t, CURLcode code) {
+    VLMHttpResult result;
+    result.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t->start);
+    long connects = 0;
+    curl_easy_getinfo(t->easy, CURLINFO_RESPONSE_CODE, &result.status);
+    curl_easy_getinfo(t->easy, CURLINFO_NUM_CONNECTS, &connects);
+    connects_.fetch_add(connects, std::memory_order_relaxed);
+
+    if (code != CURLE_OK) {
+      result.error = curl_easy_strerror(code);
+      if (code == CURLE_OPERATION_TIMEDOUT) {
+        timeouts_.fetch_add(1, std::memory_order_relaxed);
+      }
+    } else if (result.status != 200) {
+      result.error = "HTTP " + std::to_string(result.status) + ": " + t->response.substr(0, 256);
+    } else if (t->kind == Transfer::Body::EVENTS) {
+      t->sse.finish([t](std::string_view event) { t->client->on_event(t, event); });
+      finish_stream(t, result);
+    } else {
+      parse_completion(t->response, result);
+    }
+    curl_multi_remove_handle(multi_, t->easy);
+    idle_.push_back(t->easy);
+    complete(t, std::move(result));
+  }
+
+  static void parse_completion(const std::string &response, VLMHttpResult &result) {
+    nlohmann::json reply = nlohmann::json::parse(response, nullptr, false);
+    if (reply.is_discarded()) {
+      result.error = "response is not JSON";
+      return;
+    }
+    try {
+      result.content = reply.at("choices").at(0).at("message").at("content").get<std::string>();
+      result.model = reply.value("model", "");
+      result.ok = true;
+    } catch (const nlohmann::json::exception &) {
+      result.error = "no choices[0].message.content in response";
+    }
+  }
+
+  // One event of a streamed reply: a chat.completion.chunk, an error, or
+  // the closing [DONE]
+  void on_event(Transfer *t, std::string_view data) {
+    if (data == "[DONE]") {
+      t->finished = true;
+      return;
+    }
+    nlohmann::json chunk = nlohmann::json::parse(data, nullptr, false);
+    if (chunk.is_discarded() || !chunk.is_object()) {
+      return;
+    }
+    if (chunk.contains("error")) {
+      const nlohmann::json &error = chunk["error"];
+      t->error = error.is_object() ? error.value("message", error.dump()) : error.dump();
+      return;
+    }
+    if (t->model.empty()) {
+      t->model = chunk.value("model", "");
+    }
+    auto choices = chunk.find("choices");
+    if (choices == chunk.end() || !choices->is_array() || choices->empty()) {
+      return;  // e.g. a trailing usage-only chunk
+    }
+    auto delta = (*choices)[0].find("delta");
+    if (delta == (*choices)[0].end() || !delta->is_object()) {
+      return;
+    }
+    auto text = delta->find("content");
+    if (text == delta->end() || !text->is_string() || text->get_ref<const std::string &>().empty()) {
+      return;  // Role-only or finish_reason chunk
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (t->tokens++ == 0) {
+      t->first_token = now;
+      t->last_flush = now;
+    }
+    t->content += text->get_ref<const std::string &>();
+    if (t->partial &&
+        (t->tokens - t->flushed_tokens >= config_.stream_flush_tokens ||
+         now - t->last_flush >= config_.stream_flush_interval)) {
+      t->flushed_tokens = t->tokens;
+      t->last_flush = now;
+      partials_.fetch_add(1, std::memory_order_relaxed);
+      t->partial(t->content, t->tokens, t->model);
+    }
+  }
+
+  void finish_stream(Transfer *t, VLMHttpResult &result) {
+    result.tokens = t->tokens;
+    if (t->tokens > 0) {
+      result.first_token = std::chrono::duration_cast<std::chrono::microseconds>(
+          t->first_token - t->start);
+    }
+    if (!t->error.empty()) {
+      result.error = t->error;
+    } else if (t->tokens == 0 && !t->finished) {
+      result.error = "event stream ended without content";
+    } else {
+      result.content = std::move(t->content);
+      result.model = std::move(t->model);
+      result.ok = true;
+    }
+  }
+
+  // Removes `t` from active_, runs its callback and frees its slot
+  void complete(Transfer *t, VLMHttpResult result) {
+    std::unique_ptr<Transfer> owned;
+    for (auto it = active_.begin(); it != active_.end(); ++it) {
+      if (it->get() == t) {
+        owned = std::move(*it);
+        *it = std::move(active_.back());
+        active_.pop_back();
+        break;
+      }
+    }
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    if (!result.ok) {
+      failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (owned->done) {
+      owned->done(std::move(result));
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      --inflight_;
+    }
+    slot_free_.notify_all();  // A submitter and/or drain()
+  }
+
+  void io_loop() {
+    std::vector<std::unique_ptr<Transfer>> incoming;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(m_);
+        if (stopping_) {
+          break;
+        }
+        incoming.swap(pending_);
+      }
+      for (auto &transfer : incoming) {
+        start(std::move(transfer));
+      }
+      incoming.clear();
+
+      int running = 0;
+      curl_multi_perform(multi_, &running);
+      int queued = 0;
+      while (CURLMsg *msg = curl_multi_info_read(multi_, &queued)) {
+        if (msg->msg != CURLMSG_DONE) {
+          continue;
+        }
+        Transfer *t = nullptr;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char **)&t);
+        finish(t, msg->data.result);
+      }
+      curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+    }
+
+    // Shutting down: fail whatever is still queued or on the wire
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      incoming.swap(pending_);
+    }
+    for (auto &transfer : incoming) {
+      active_.push_back(std::move(transfer));
+    }
+    while (!active_.empty()) {
+      Transfer *t = active_.back().get();
+      if (t->easy) {
+        curl_multi_remove_handle(multi_, t->easy);
+        idle_.push_back(t->easy);
+      }
+      VLMHttpResult cancelled;
+      cancelled.error = "cancelled";
+      complete(t, std::move(cancelled));
+    }
+  }
+
+  VLMHttpClientConfig config_;
+  CURLM *multi_ = nullptr;
+  struct curl_slist *headers_ = nullptr;
+
+  // I/O thread only
+  std::vector<std::unique_ptr<Transfer>> active_{};
+  std::vector<CURL *> idle_{};
+
+  mutable std::mutex m_{};
+  std::condition_variable slot_free_{};
+  std::vector<std::unique_ptr<Transfer>> pending_{};
+  size_t inflight_ = 0;           // Pending plus active
+  bool stopping_ = false;
+
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> failures_{0};
+  std::atomic<uint64_t> timeouts_{0};
+  std::atomic<uint64_t> connects_{0};
+  std::atomic<uint64_t> partials_{0};
+  std::thread io_thread_{};
+};
+
+#endif  // VLM_HTTP_CLIENT_H_
@@ -0,0 +1,215 @@
+#ifndef VLM_RATE_CONTROLLER_H_
+#define VLM_RATE_CONTROLLER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct VLMRateControllerConfig {
+  double min_interval = 1;        // Densest sampling, in frames
+  double max_interval = 300;      // Sparsest sampling, in frames
+  double initial_interval = 30;   // For a source's first frames
+  // Backend latency above which the backend counts as overloaded
+  std::chrono::milliseconds target_latency{2000};
+  double queue_high_water = 0.5;  // Queue fill counted as congestion
+  double queue_low_water = 0.1;   // Fill below which sampling may speed up
+  double increase = 0.2;          // Additive, samples/s per source per update
+  double decrease = 0.5;          // Multiplicative, on congestion
+  double latency_smoothing = 0.2; // EWMA weight of each new latency sample
+  std::chrono::milliseconds update_period{1000};
+};
+
+// Adaptive per-source sampling interval for the VLM queue (AIMD).
+//
+// should_sample() replaces a fixed "every Nth frame": each source has its
+// own interval, fractional so that slow sources are not rounded away. Every
+// update_period, update() looks at the queue and at the smoothed latency of
+// completed backend requests (record_latency). The backend is congested
+// when frames were dropped since the last update, the queue is filled past
+// queue_high_water, or latency exceeds target_latency; every source's
+// sample rate is then multiplied by `decrease`. When the queue is below
+// queue_low_water and latency is within target, each rate grows by
+// `increase` samples/s; otherwise rates hold. As with TCP congestion
+// control, sources sharing one backend converge on equal shares of its
+// capacity. Intervals are kept within [min_interval, max_interval].
+//
+// should_sample() and update() belong to the streaming thread;
+// record_latency() and rates() may be called from any thread.
+class VLMRateController {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Signals {
+    size_t queue_depth = 0;
+    size_t queue_capacity = 0;    // 0 = unbounded, fill not considered
+    uint64_t dropped = 0;         // Cumulative; only growth is considered
+  };
+
+  enum class Decision { HOLD, INCREASE, DECREASE };
+
+  struct SourceRate {
+    uint32_t source_id;
+    double interval;              // Frames per sample
+    double frame_rate;            // Frames/s seen from the source
+    double sample_rate;           // Samples/s sent to the VLM
+  };
+
+  struct Stats {
+    uint64_t updates;
+    uint64_t increases;
+    uint64_t decreases;
+    double latency_ms;            // Smoothed backend latency, 0 before any sample
+    Decision last;
+  };
+
+  explicit VLMRateController(VLMRateControllerConfig config = VLMRateControllerConfig())
+      : config_(config) {
+    config_.min_interval = std::max(1.0, config_.min_interval);
+    config_.max_interval = std::max(config_.min_interval, config_.max_interval);
+    config_.initial_interval =
+        std::clamp(config_.initial_interval, config_.min_interval, config_.max_interval);
+  }
+
+  const VLMRateControllerConfig &config() const { return config_; }
+
+  // Counts a frame of `source_id`; true if it should go to the VLM
+  bool should_sample(uint32_t source_id) {
+    std::lock_guard<std::mutex> lock(m_);
+    Source &source = source_locked(source_id);
+    ++source.window_frames;
+    source.phase += 1;
+    if (source.phase < source.interval) {
+      return false;
+    }
+    source.phase -= source.interval;
+    if (source.phase >= source.interval) {
+      source.phase = 0;           // Interval just shrank below the backlog
+    }
+    return true;
+  }
+
+  // Time a backend request took to complete
+  void record_latency(std::chrono::microseconds latency) {
+    double ms = latency.count() / 1000.0;
+    std::lock_guard<std::mutex> lock(m_);
+    latency_ms_ = have_latency_
+                      ? latency_ms_ + config_.latency_smoothing * (ms - latency_ms_)
+                      : ms;
+    have_latency_ = true;
+  }
+
+  // Runs the control law once update_period has passed since the last
+  // time it did; returns true if it ran.
+  bool update(const Signals &signals, Clock::time_point now = Clock::now()) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (last_update_ == Clock::time_point()) {
+      last_update_ = now;
+      last_dropped_ = signals.dropped;
+      return false;
+    }
+    if (now - last_update_ < config_.update_period) {
+      return false;
+    }
+    double elapsed = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    double fill = signals.queue_capacity > 0
+                      ? (double)signals.queue_depth / signals.queue_capacity
+                      : 0.0;
+    bool dropped = signals.dropped > last_dropped_;
+    last_dropped_ = signals.dropped;
+    bool slow = have_latency_ && latency_ms_ > config_.target_latency.count();
+
+    Decision decision = Decision::HOLD;
+    if (dropped || fill >= config_.queue_high_water || slow) {
+      decision = Decision::DECREASE;
+    } else if (fill <= config_.queue_low_water) {
+      decision = Decision::INCREASE;
+    }
+
+    for (auto &entry : sources_) {
+      Source &source = entry.second;
+      if (source.window_frames == 0) {
+        continue;                 // Idle source: keeps its interval
+      }
+      double frame_rate = source.window_frames / elapsed;
+      source.window_frames = 0;
+      source.frame_rate = source.frame_rate > 0
+                              ? 0.5 * (source.frame_rate + frame_rate)
+                              : frame_rate;
+      double rate = source.frame_rate / source.interval;
+      if (decision == Decision::DECREASE) {
+        rate *= config_.decrease;
+      } else if (decision == Decision::INCREASE) {
+        rate += config_.increase;
+      }
+      source.interval = std::clamp(source.frame_rate / rate, config_.min_interval,
+                                   config_.max_interval);
+    }
+
+    ++updates_;
+    if (decision == Decision::INCREASE) {
+      ++increases_;
+    } else if (decision == Decision::DECREASE) {
+      ++decreases_;
+    }
+    last_decision_ = decision;
+    return true;
+  }
+
+  std::vector<SourceRate> rates() const {
+    std::lock_guard<std::mutex> lock(m_);
+    std::vector<SourceRate> rates;
+    rates.reserve(sources_.size());
+    for (const auto &entry : sources_) {
+      const Source &source = entry.second;
+      rates.push_back({entry.first, source.interval, source.frame_rate,
+                       source.frame_rate / source.interval});
+    }
+    std::sort(rates.begin(), rates.end(), [](const SourceRate &a, const SourceRate &b) {
+      return a.source_id < b.source_id;
+    });
+    return rates;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return {updates_, increases_, decreases_, have_latency_ ? latency_ms_ : 0.0,
+            last_decision_};
+  }
+
+ private:
+  struct Source {
+    double interval;
+    double phase;                 // Frames since the last sample
+    uint64_t window_frames = 0;   // Since the last update
+    double frame_rate = 0;
+  };
+
+  Source &source_locked(uint32_t source_id) {
+    auto it = sources_.find(source_id);
+    if (it == sources_.end()) {
+      // The first frame of a source is sampled
+      it = sources_.emplace(source_id, Source{config_.initial_interval,
+                                              config_.initial_interval - 1}).first;
+    }
+    return it->second;
+  }
+
+  VLMRateControllerConfig config_;
+  mutable std::mutex m_{};
+  std::unordered_map<uint32_t, Source> sources_{};
+  Clock::time_point last_update_{};
+  uint64_t last_dropped_ = 0;
+  double latency_ms_ = 0;
+  bool have_latency_ = false;
+  uint64_t updates_ = 0;
+  uint64_t increases_ = 0;
+  uint64_t decreases_ = 0;
+  Decision last_decision_ = Decision::HOLD;
+};
+
+#endif  // VLM_RATE_CONTROLLER_H_
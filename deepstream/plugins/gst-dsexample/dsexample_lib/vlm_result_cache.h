@@ -0,0 +1,147 @@
+#ifndef VLM_RESULT_CACHE_H_
+#define VLM_RESULT_CACHE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+struct VLMResultCacheConfig {
+  size_t capacity = 1024;         // Entries kept; least recently used go first
+  int max_distance = 4;           // Hash bits two frames may differ by
+  std::chrono::seconds ttl{300};  // Entries older than this are not reused
+};
+
+// A response the backend gave for one frame, as reused for later frames
+struct VLMCachedResult {
+  std::string response;
+  std::string model;
+
+  // "<model>\n<response>", the form shared through Redis
+  std::string serialize() const { return model + '\n' + response; }
+
+  static std::optional<VLMCachedResult> parse(std::string_view value) {
+    size_t newline = value.find('\n');
+    if (newline == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return VLMCachedResult{std::string(value.substr(newline + 1)),
+                           std::string(value.substr(0, newline))};
+  }
+};
+
+// Stable 64-bit key of a prompt and the model it is sent to (FNV-1a), the
+// same on every node so that it can be part of a shared cache key
+inline uint64_t vlm_prompt_key(std::string_view prompt, std::string_view model) {
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](std::string_view text) {
+    for (unsigned char c : text) {
+      hash = (hash ^ c) * 1099511628211ull;
+    }
+  };
+  mix(prompt);
+  mix(std::string_view("\0", 1));
+  mix(model);
+  return hash;
+}
+
+// LRU cache of VLM responses keyed by prompt and perceptual image hash.
+//
+// lookup() finds the entry for the same prompt whose image hash is nearest
+// the frame's, within max_distance bits (Hamming), so a frame that differs
+// from an earlier one only by noise or compression reuses its response
+// instead of costing a backend request. Entries are scanned linearly: a
+// 64-bit compare per entry is cheap next to the request it saves, and
+// near matches cannot be found by key. Safe to call from any thread.
+class VLMResultCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+  };
+
+  explicit VLMResultCache(VLMResultCacheConfig config = VLMResultCacheConfig())
+      : config_(config) {}
+
+  const VLMResultCacheConfig &config() const { return config_; }
+
+  std::optional<VLMCachedResult> lookup(uint64_t prompt_key, uint64_t image_hash,
+                                        Clock::time_point now = Clock::now()) {
+    std::lock_guard<std::mutex> lock(m_);
+    auto best = lru_.end();
+    int best_distance = config_.max_distance + 1;
+    for (auto it = lru_.begin(); it != lru_.end();) {
+      if (now - it->inserted > config_.ttl) {
+        it = lru_.erase(it);
+        continue;
+      }
+      if (it->prompt_key == prompt_key) {
+        int distance = __builtin_popcountll(it->image_hash ^ image_hash);
+        if (distance < best_distance) {
+          best = it;
+          best_distance = distance;
+          if (distance == 0) {
+            break;
+          }
+        }
+      }
+      ++it;
+    }
+    if (best == lru_.end()) {
+      ++misses_;
+      return std::nullopt;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, best);
+    return best->result;
+  }
+
+  // Adds or refreshes the entry for exactly this prompt and hash
+  void insert(uint64_t prompt_key, uint64_t image_hash, VLMCachedResult result,
+              Clock::time_point now = Clock::now()) {
+    if (config_.capacity == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_);
+    for (auto it = lru_.begin(); it != lru_.end(); ++it) {
+      if (it->prompt_key == prompt_key && it->image_hash == image_hash) {
+        lru_.erase(it);
+        break;
+      }
+    }
+    lru_.push_front({prompt_key, image_hash, std::move(result), now});
+    while (lru_.size() > config_.capacity) {
+      lru_.pop_back();
+      ++evictions_;
+    }
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return {hits_, misses_, evictions_, lru_.size()};
+  }
+
+ private:
+  struct Entry {
+    uint64_t prompt_key;
+    uint64_t image_hash;
+    VLMCachedResult result;
+    Clock::time_point inserted;
+  };
+
+  VLMResultCacheConfig config_;
+  mutable std::mutex m_{};
+  std::list<Entry> lru_{};        // Most recently used first
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+#endif  // VLM_RESULT_CACHE_H_
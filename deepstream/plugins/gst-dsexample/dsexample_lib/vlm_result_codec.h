@@ -0,0 +1,304 @@
+// VLMResultCodec.h - Compact binary encoding of VLM result stream entries
+#ifndef VLM_RESULT_CODEC_H
+#define VLM_RESULT_CODEC_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef WITH_LZ4
+#include <lz4.h>
+#endif
+
+// Compression applied to the response text of a compact entry
+enum class VLMCompression : uint8_t {
+    NONE = 0,
+    ZSTD = 1,   // needs WITH_ZSTD
+    LZ4 = 2     // needs WITH_LZ4
+};
+
+// One VLM result as carried by a compact entry. The timestamp is not
+// stored: it is the millisecond part of the stream ID.
+struct VLMResultRecord {
+    uint32_t frame_number = 0;
+    uint32_t source_id = 0;
+    uint32_t model_id = 0;       // vlm_model_id() of the model name
+    std::string vlm_response;
+};
+
+// Interned model name: 32-bit FNV-1a of the name. Stable across processes,
+// so every writer registers the same id -> name pair in the model table.
+inline uint32_t vlm_model_id(std::string_view model_name) {
+    uint32_t hash = 2166136261u;
+    for (char c : model_name) {
+        hash = (hash ^ (unsigned char)c) * 16777619u;
+    }
+    return hash;
+}
+
+// A compact entry is a single stream field, kField, holding one
+// MessagePack array:
+//   [version, frame_number, source_id, model_id, compression, raw_len, response]
+// with unsigned integers in their shortest MessagePack form and the
+// response as bin (compressed when it was at least `min_compress_bytes`
+// long and compression made it smaller; raw_len is its uncompressed size).
+class VLMResultCodec {
+public:
+    static constexpr const char* kField = "vlm";
+    static constexpr uint8_t kVersion = 1;
+    static constexpr uint32_t kMaxResponseBytes = 64u << 20;   // sanity cap on decode
+
+    explicit VLMResultCodec(VLMCompression compression = VLMCompression::NONE,
+                            size_t min_compress_bytes = 512, int level = 0)
+        : compression_(available(compression) ? compression : VLMCompression::NONE),
+          min_compress_bytes_(min_compress_bytes), level_(level) {}
+
+    // Whether this build can compress (and decompress) with `compression`
+    static bool available(VLMCompression compression) {
+        switch (compression) {
+            case VLMCompression::NONE:
+                return true;
+#ifdef WITH_ZSTD
+            case VLMCompression::ZSTD:
+                return true;
+#endif
+#ifdef WITH_LZ4
+            case VLMCompression::LZ4:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    VLMCompression compression() const {
+        return compression_;
+    }
+
+    // Encode into `out` (cleared first)
+    void encode(uint32_t frame_number, uint32_t source_id, uint32_t model_id,
+                std::string_view response, std::string& out) const {
+        out.clear();
+        out.reserve(32 + response.size());
+        out.push_back((char)(0x90 | 7));   // fixarray, 7 elements
+        put_uint(out, kVersion);
+        put_uint(out, frame_number);
+        put_uint(out, source_id);
+        put_uint(out, model_id);
+
+        size_t header = out.size();
+        if (compression_ != VLMCompression::NONE && response.size() >= min_compress_bytes_) {
+            put_uint(out, (uint64_t)compression_);
+            put_uint(out, response.size());
+            if (put_compressed(out, response)) return;
+            out.resize(header);   // did not shrink; store it as is
+        }
+        put_uint(out, (uint64_t)VLMCompression::NONE);
+        put_uint(out, response.size());
+        put_bin(out, response.data(), response.size());
+    }
+
+    std::string encode(uint32_t frame_number, uint32_t source_id, uint32_t model_id,
+                       std::string_view response) const {
+        std::string out;
+        encode(frame_number, source_id, model_id, response, out);
+        return out;
+    }
+
+    // Decode a kField value. With `with_response` false only the numeric
+    // fields are read (no decompression). False on malformed input, an
+    // unknown version or a compression this build lacks.
+    static bool decode(std::string_view blob, VLMResultRecord& record, bool with_response = true) {
+        Reader in{blob.data(), blob.data() + blob.size()};
+        uint64_t version, frame_number, source_id, model_id, compression, raw_len;
+        if (in.end - in.p < 1 || (unsigned char)*in.p++ != (0x90 | 7)) return false;
+        if (!in.get_uint(version) || version != kVersion) return false;
+        if (!in.get_uint(frame_number) || !in.get_uint(source_id) || !in.get_uint(model_id) ||
+            !in.get_uint(compression) || !in.get_uint(raw_len)) {
+            return false;
+        }
+        record.frame_number = (uint32_t)frame_number;
+        record.source_id = (uint32_t)source_id;
+        record.model_id = (uint32_t)model_id;
+        if (!with_response) return true;
+
+        const char* data;
+        size_t len;
+        if (!in.get_bin(data, len) || raw_len > kMaxResponseBytes) return false;
+        return decompress((VLMCompression)compression, data, len, raw_len, record.vlm_response);
+    }
+
+private:
+    struct Reader {
+        const char* p;
+        const char* end;
+
+        bool get_uint(uint64_t& value) {
+            if (p >= end) return false;
+            unsigned char tag = (unsigned char)*p++;
+            if (tag < 0x80) {
+                value = tag;
+                return true;
+            }
+            size_t width = tag == 0xcc ? 1 : tag == 0xcd ? 2 : tag == 0xce ? 4 : tag == 0xcf ? 8 : 0;
+            if (width == 0 || (size_t)(end - p) < width) return false;
+            value = 0;
+            for (size_t i = 0; i < width; i++) {
+                value = (value << 8) | (unsigned char)p[i];
+            }
+            p += width;
+            return true;
+        }
+
+        bool get_bin(const char*& data, size_t& len) {
+            if (p >= end) return false;
+            unsigned char tag = (unsigned char)*p++;
+            size_t width = tag == 0xc4 ? 1 : tag == 0xc5 ? 2 : tag == 0xc6 ? 4 : 0;
+            if (width == 0 || (size_t)(end - p) < width) return false;
+            len = 0;
+            for (size_t i = 0; i < width; i++) {
+                len = (len << 8) | (unsigned char)p[i];
+            }
+            p += width;
+            if ((size_t)(end - p) < len) return false;
+            data = p;
+            p += len;
+            return true;
+        }
+    };
+
+    static void put_be(std::string& out, uint64_t value, size_t width) {
+        for (size_t i = width; i-- > 0;) {
+            out.push_back((char)(value >> (8 * i)));
+        }
+    }
+
+    static void put_uint(std::string& out, uint64_t value) {
+        if (value < 0x80) {
+            out.push_back((char)value);
+        } else if (value <= 0xff) {
+            out.push_back((char)0xcc);
+            put_be(out, value, 1);
+        } else if (value <= 0xffff) {
+            out.push_back((char)0xcd);
+            put_be(out, value, 2);
+        } else if (value <= 0xffffffffull) {
+            out.push_back((char)0xce);
+            put_be(out, value, 4);
+        } else {
+            out.push_back((char)0xcf);
+            put_be(out, value, 8);
+        }
+    }
+
+    static void put_bin_header(std::string& out, size_t len) {
+        if (len <= 0xff) {
+            out.push_back((char)0xc4);
+            put_be(out, len, 1);
+        } else if (len <= 0xffff) {
+            out.push_back((char)0xc5);
+            put_be(out, len, 2);
+        } else {
+            out.push_back((char)0xc6);
+            put_be(out, len, 4);
+        }
+    }
+
+    static void put_bin(std::string& out, const char* data, size_t len) {
+        put_bin_header(out, len);
+        out.append(data, len);
+    }
+
+    // Append the compressed response as bin. False, leaving `out` as it
+    // was, if it would not be smaller.
+    bool put_compressed(std::string& out, std::string_view response) const {
+        std::string& scratch = scratch_buffer();
+        size_t written = 0;
+        switch (compression_) {
+#ifdef WITH_ZSTD
+            case VLMCompression::ZSTD: {
+                scratch.resize(ZSTD_compressBound(response.size()));
+                size_t n = ZSTD_compressCCtx(zstd_cctx(), scratch.data(), scratch.size(), response.data(),
+                                             response.size(), level_ > 0 ? level_ : 3);
+                if (ZSTD_isError(n)) return false;
+                written = n;
+                break;
+            }
+#endif
+#ifdef WITH_LZ4
+            case VLMCompression::LZ4: {
+                scratch.resize(LZ4_compressBound((int)response.size()));
+                int n = level_ > 1 ? LZ4_compress_fast(response.data(), scratch.data(), (int)response.size(),
+                                                       (int)scratch.size(), level_)
+                                   : LZ4_compress_default(response.data(), scratch.data(), (int)response.size(),
+                                                          (int)scratch.size());
+                if (n <= 0) return false;
+                written = (size_t)n;
+                break;
+            }
+#endif
+            default:
+                return false;
+        }
+        if (written >= response.size()) return false;
+        put_bin(out, scratch.data(), written);
+        return true;
+    }
+
+    static bool decompress(VLMCompression compression, const char* data, size_t len, size_t raw_len,
+                           std::string& out) {
+        switch (compression) {
+            case VLMCompression::NONE:
+                if (len != raw_len) return false;
+                out.assign(data, len);
+                return true;
+#ifdef WITH_ZSTD
+            case VLMCompression::ZSTD: {
+                out.resize(raw_len);
+                size_t n = ZSTD_decompressDCtx(zstd_dctx(), out.data(), raw_len, data, len);
+                return !ZSTD_isError(n) && n == raw_len;
+            }
+#endif
+#ifdef WITH_LZ4
+            case VLMCompression::LZ4: {
+                out.resize(raw_len);
+                int n = LZ4_decompress_safe(data, out.data(), (int)len, (int)raw_len);
+                return n >= 0 && (size_t)n == raw_len;
+            }
+#endif
+            default:
+                return false;
+        }
+    }
+
+    // Compression output buffer, reused per thread
+    static std::string& scratch_buffer() {
+        thread_local std::string scratch;
+        return scratch;
+    }
+
+#ifdef WITH_ZSTD
+    // Per-thread contexts; creating one per call costs more than
+    // compressing a typical response
+    static ZSTD_CCtx* zstd_cctx() {
+        thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> cctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+        return cctx.get();
+    }
+
+    static ZSTD_DCtx* zstd_dctx() {
+        thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+        return dctx.get();
+    }
+#endif
+
+    VLMCompression compression_;
+    size_t min_compress_bytes_;
+    int level_;
+};
+
+#endif // VLM_RESULT_CODEC_H
@@ -0,0 +1,190 @@
+#ifndef VLM_RESULT_PUBLISHER_H_
+#define VLM_RESULT_PUBLISHER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A VLM result, or the partial result of a reply still streaming, waiting
+// to be written to Redis
+struct VLMPublishItem {
+  enum class Kind { RESULT, PARTIAL };
+
+  Kind kind = Kind::RESULT;
+  uint32_t source_id = 0;
+  uint32_t frame_number = 0;
+  std::string text;
+  std::string model;
+  bool cached = false;            // RESULT reused from an earlier frame
+  bool share = false;             // RESULT to store in the shared cache too
+  uint64_t prompt_key = 0;        // Key it is shared under, with image_hash
+  uint64_t image_hash = 0;
+  int share_ttl_sec = 0;
+  uint64_t tokens = 0;            // PARTIAL: tokens generated so far
+};
+
+// Moves Redis writes off the threads that produce results.
+//
+// publish() only queues; one publisher thread hands whatever is queued, up
+// to kMaxBatch items at a time, to the handler, which writes it and returns
+// how many items failed. The HTTP client's I/O thread, which drives every
+// outstanding backend request, therefore never waits on Redis: a slow or
+// unreachable Redis backs up this queue instead of stalling transfers.
+// When `capacity` items are waiting the oldest is dropped and counted.
+//
+// Partial results are best effort and superseded by the next one, so they
+// never pile up: a partial replaces one still queued for the same frame,
+// a new one is dropped while `max_partials` are queued, and a frame's
+// result discards its queued partials.
+class VLMResultPublisher {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Handler = std::function<size_t(std::vector<VLMPublishItem> &batch)>;
+
+  static constexpr size_t kMaxBatch = 256;
+
+  struct Stats {
+    uint64_t published;
+    uint64_t failed;              // Rejected by the handler
+    uint64_t dropped;             // Results never handed to it
+    uint64_t partials_coalesced;  // Replaced or superseded while queued
+    uint64_t partials_dropped;    // Turned away with max_partials queued
+    size_t pending;
+  };
+
+  explicit VLMResultPublisher(Handler handler, size_t capacity = 4096,
+                              size_t max_partials = 64)
+      : handler_(std::move(handler)),
+        capacity_(std::max<size_t>(1, capacity)),
+        max_partials_(max_partials) {
+    thread_ = std::thread(&VLMResultPublisher::run, this);
+  }
+
+  ~VLMResultPublisher() { stop(std::chrono::milliseconds(0)); }
+
+  VLMResultPublisher(const VLMResultPublisher &) = delete;
+  VLMResultPublisher &operator=(const VLMResultPublisher &) = delete;
+
+  // Safe from any thread; never waits on the handler
+  void publish(VLMPublishItem item) {
+    std::lock_guard<std::mutex> lock(m_);
+    bool partial = item.kind == VLMPublishItem::Kind::PARTIAL;
+    if (stopping_) {
+      ++(partial ? partials_dropped_ : dropped_);
+      return;
+    }
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      if (it->kind != VLMPublishItem::Kind::PARTIAL ||
+          it->source_id != item.source_id || it->frame_number != item.frame_number) {
+        ++it;
+      } else if (partial) {
+        *it = std::move(item);    // Keeps its place in the queue
+        ++partials_coalesced_;
+        return;
+      } else {
+        it = queue_.erase(it);
+        --partials_;
+        ++partials_coalesced_;
+      }
+    }
+    if (partial && partials_ >= max_partials_) {
+      ++partials_dropped_;
+      return;
+    }
+    if (queue_.size() >= capacity_) {
+      pop_front_locked(true);
+    }
+    partials_ += partial;
+    queue_.push_back(std::move(item));
+    cv_.notify_one();
+  }
+
+  // Keeps handling what is queued for up to `timeout`, then stops the
+  // thread and drops the rest. True if nothing was left.
+  bool stop(std::chrono::milliseconds timeout) {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (stopping_) {
+        return true;
+      }
+      stopping_ = true;
+      deadline_ = Clock::now() + timeout;
+    }
+    cv_.notify_all();
+    thread_.join();
+    std::lock_guard<std::mutex> lock(m_);
+    return abandoned_ == 0;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return {published_, failed_, dropped_, partials_coalesced_, partials_dropped_,
+            queue_.size()};
+  }
+
+ private:
+  void pop_front_locked(bool drop) {
+    if (queue_.front().kind == VLMPublishItem::Kind::PARTIAL) {
+      --partials_;
+      partials_dropped_ += drop;
+    } else {
+      dropped_ += drop;
+    }
+    queue_.pop_front();
+  }
+
+  void run() {
+    std::vector<VLMPublishItem> batch;
+    std::unique_lock<std::mutex> lock(m_);
+    for (;;) {
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty() || (stopping_ && Clock::now() >= deadline_)) {
+        break;
+      }
+      size_t count = std::min(queue_.size(), kMaxBatch);
+      batch.assign(std::make_move_iterator(queue_.begin()),
+                   std::make_move_iterator(queue_.begin() + count));
+      while (count-- > 0) {
+        pop_front_locked(false);
+      }
+
+      lock.unlock();
+      size_t failed = std::min(handler_(batch), batch.size());
+      lock.lock();
+      published_ += batch.size() - failed;
+      failed_ += failed;
+      batch.clear();
+    }
+    abandoned_ = queue_.size();
+    while (!queue_.empty()) {
+      pop_front_locked(true);
+    }
+  }
+
+  Handler handler_;
+  size_t capacity_;
+  size_t max_partials_;
+  mutable std::mutex m_{};
+  std::condition_variable cv_{};
+  std::deque<VLMPublishItem> queue_{};
+  bool stopping_ = false;
+  Clock::time_point deadline_{};
+  uint64_t published_ = 0;
+  uint64_t failed_ = 0;
+  uint64_t dropped_ = 0;
+  uint64_t partials_coalesced_ = 0;
+  uint64_t partials_dropped_ = 0;
+  size_t partials_ = 0;           // Of queue_
+  size_t abandoned_ = 0;
+  std::thread thread_{};
+};
+
+#endif  // VLM_RESULT_PUBLISHER_H_
@@ -40,7 +40,48 @@ enum
   PROP_VLM_ENABLED,
   PROP_VLM_QUEUE_SIZE,
   PROP_VLM_FRAME_INTERVAL,
-  PROP_VLM_SERVICE_URL
+  PROP_VLM_SERVICE_URL,
+  PROP_VLM_QUEUE_POLICY,
+  PROP_VLM_BATCH_SIZE,
+  PROP_VLM_BATCH_TIMEOUT_MS,
+  PROP_VLM_SOURCE_QUEUE_SIZE,
+  PROP_VLM_WORKERS,
+  PROP_VLM_SHARED_DISPATCHER,
+  PROP_REDIS_PIPELINE_SIZE,
+  PROP_REDIS_PIPELINE_FLUSH_US,
+  PROP_REDIS_STREAM_MAXLEN,
+  PROP_REDIS_RETENTION_SEC,
+  PROP_REDIS_PENDING_RECOVERY_SEC,
+  PROP_REDIS_STREAM_LAYOUT,
+  PROP_REDIS_CLUSTER,
+  PROP_REDIS_SPILL_DIR,
+  PROP_REDIS_SPILL_MAX_MB,
+  PROP_REDIS_COMPACT,
+  PROP_REDIS_COMPRESSION,
+  PROP_REDIS_HOST,
+  PROP_REDIS_PORT,
+  PROP_REDIS_UNIX_SOCKET,
+  PROP_REDIS_CONNECT_TIMEOUT_MS,
+  PROP_REDIS_COMMAND_TIMEOUT_MS,
+  PROP_REDIS_KEEPALIVE_SEC,
+  PROP_REDIS_TCP_NODELAY,
+  PROP_VLM_MODEL,
+  PROP_VLM_PROMPT,
+  PROP_VLM_REQUEST_TIMEOUT_MS,
+  PROP_VLM_MAX_INFLIGHT,
+  PROP_VLM_STREAM,
+  PROP_VLM_STREAM_FLUSH_TOKENS,
+  PROP_VLM_STREAM_FLUSH_MS,
+  PROP_VLM_ADAPTIVE_INTERVAL,
+  PROP_VLM_MIN_FRAME_INTERVAL,
+  PROP_VLM_MAX_FRAME_INTERVAL,
+  PROP_VLM_TARGET_LATENCY_MS,
+  PROP_VLM_SCENE_THRESHOLD,
+  PROP_VLM_SCENE_MAX_STALENESS_MS,
+  PROP_VLM_CACHE_SIZE,
+  PROP_VLM_CACHE_MAX_DISTANCE,
+  PROP_VLM_CACHE_TTL_SEC,
+  PROP_VLM_CACHE_REDIS
 };
 
 #define CHECK_NVDS_MEMORY_AND_GPUID(object, surface)  \
@@ -68,6 +109,63 @@ enum
 #define DEFAULT_BLUR_OBJECTS FALSE
 #define DEFAULT_GPU_ID 0
 #define DEFAULT_BATCH_SIZE 1
+#define DEFAULT_VLM_QUEUE_POLICY GST_DSEXAMPLE_VLM_QUEUE_FIFO
+#define DEFAULT_VLM_BATCH_SIZE 1
+#define DEFAULT_VLM_BATCH_TIMEOUT_MS 50
+#define MAX_VLM_BATCH_SIZE 64
+#define DEFAULT_VLM_SOURCE_QUEUE_SIZE 10
+#define DEFAULT_VLM_WORKERS 1
+#define MAX_VLM_WORKERS 64
+#define DEFAULT_VLM_SHARED_DISPATCHER FALSE
+#define DEFAULT_VLM_SERVICE_URL "http://localhost:8000/v1/chat/completions"
+#define DEFAULT_VLM_MODEL NULL
+#define DEFAULT_VLM_PROMPT "Describe what is happening in this image."
+#define DEFAULT_VLM_REQUEST_TIMEOUT_MS 30000
+#define DEFAULT_VLM_MAX_INFLIGHT 32
+#define MAX_VLM_MAX_INFLIGHT 1024
+#define DEFAULT_VLM_STREAM FALSE
+#define DEFAULT_VLM_STREAM_FLUSH_TOKENS 8
+#define DEFAULT_VLM_STREAM_FLUSH_MS 250
+#define DEFAULT_VLM_ADAPTIVE_INTERVAL FALSE
+#define DEFAULT_VLM_MIN_FRAME_INTERVAL 1
+#define DEFAULT_VLM_MAX_FRAME_INTERVAL 300
+#define MAX_VLM_FRAME_INTERVAL 3000
+#define DEFAULT_VLM_TARGET_LATENCY_MS 2000
+#define DEFAULT_VLM_SCENE_THRESHOLD 0.0
+#define DEFAULT_VLM_SCENE_MAX_STALENESS_MS 30000
+#define DEFAULT_VLM_CACHE_SIZE 0
+#define DEFAULT_VLM_CACHE_MAX_DISTANCE 4
+#define DEFAULT_VLM_CACHE_TTL_SEC 300
+#define DEFAULT_VLM_CACHE_REDIS FALSE
+/* Quality of JPEG-encoded frames sent to the VLM (OpenCV builds) */
+#define VLM_JPEG_QUALITY 85
+/* Model name published with results when the server does not report one */
+#define VLM_RESULT_MODEL_FALLBACK "deepstream_vlm_v1"
+#define DEFAULT_REDIS_HOST "localhost"
+#define DEFAULT_REDIS_PORT 6379
+#define DEFAULT_REDIS_UNIX_SOCKET NULL
+#define DEFAULT_REDIS_CONNECT_TIMEOUT_MS 1000
+#define DEFAULT_REDIS_COMMAND_TIMEOUT_MS 0
+#define DEFAULT_REDIS_KEEPALIVE_SEC 15
+#define DEFAULT_REDIS_TCP_NODELAY TRUE
+#define DEFAULT_REDIS_PIPELINE_SIZE 64
+#define MAX_REDIS_PIPELINE_SIZE 4096
+#define DEFAULT_REDIS_PIPELINE_FLUSH_US 500
+#define DEFAULT_REDIS_STREAM_MAXLEN 100000
+#define DEFAULT_REDIS_RETENTION_SEC 0
+#define DEFAULT_REDIS_PENDING_RECOVERY_SEC 0
+#define DEFAULT_REDIS_STREAM_LAYOUT GST_DSEXAMPLE_REDIS_LAYOUT_GLOBAL
+#define DEFAULT_REDIS_CLUSTER FALSE
+#define DEFAULT_REDIS_SPILL_DIR NULL
+#define DEFAULT_REDIS_SPILL_MAX_MB 128
+#define DEFAULT_REDIS_COMPACT FALSE
+#define DEFAULT_REDIS_COMPRESSION GST_DSEXAMPLE_REDIS_COMPRESSION_NONE
+/* Responses shorter than this are stored uncompressed */
+#define REDIS_COMPRESS_MIN_BYTES 512
+/* How often the retention task trims the streams */
+#define REDIS_RETENTION_INTERVAL_MS 60000
+/* How often pending recovery scans the result consumer group */
+#define REDIS_PENDING_RECOVERY_INTERVAL_MS 10000
 
 #define RGB_BYTES_PER_PIXEL 3
 #define RGBA_BYTES_PER_PIXEL 4
@@ -112,6 +210,120 @@ GST_STATIC_PAD_TEMPLATE ("src",
         (GST_CAPS_FEATURE_MEMORY_NVMM,
             "{ NV12, RGBA, I420 }")));
 
+#define GST_TYPE_DSEXAMPLE_VLM_QUEUE_POLICY \
+    (gst_dsexample_vlm_queue_policy_get_type ())
+
+static GType
+gst_dsexample_vlm_queue_policy_get_type (void)
+{
+  static GType policy_type = 0;
+  static const GEnumValue policy_values[] = {
+    {GST_DSEXAMPLE_VLM_QUEUE_FIFO,
+        "Mutex protected FIFO", "fifo"},
+    {GST_DSEXAMPLE_VLM_QUEUE_LOCKFREE,
+        "Lock-free ring buffer, drop oldest when full", "lockfree"},
+    {GST_DSEXAMPLE_VLM_QUEUE_FAIR,
+        "Per-source queues served by deficit round-robin", "fair"},
+    {GST_DSEXAMPLE_VLM_QUEUE_LATEST,
+        "Keep only the newest pending frame per source", "latest"},
+    {0, NULL, NULL}
+  };
+
+  if (!policy_type) {
+    policy_type =
+        g_enum_register_static ("GstDsExampleVlmQueuePolicy", policy_values);
+  }
+  return policy_type;
+}
+
+#define GST_TYPE_DSEXAMPLE_REDIS_STREAM_LAYOUT \
+    (gst_dsexample_redis_stream_layout_get_type ())
+
+static GType
+gst_dsexample_redis_stream_layout_get_type (void)
+{
+  static GType layout_type = 0;
+  static const GEnumValue layout_values[] = {
+    {GST_DSEXAMPLE_REDIS_LAYOUT_GLOBAL,
+        "Global vlm:results:stream only", "global"},
+    {GST_DSEXAMPLE_REDIS_LAYOUT_SHARDED,
+        "One vlm:results:<source_id> stream per source", "sharded"},
+    {GST_DSEXAMPLE_REDIS_LAYOUT_BOTH,
+        "Global and per-source streams", "both"},
+    {0, NULL, NULL}
+  };
+
+  if (!layout_type) {
+    layout_type = g_enum_register_static ("GstDsExampleRedisStreamLayout",
+        layout_values);
+  }
+  return layout_type;
+}
+
+static StreamLayout
+gst_dsexample_stream_layout (GstDsExampleRedisStreamLayout layout)
+{
+  switch (layout) {
+    case GST_DSEXAMPLE_REDIS_LAYOUT_SHARDED:
+      return StreamLayout::SHARDED;
+    case GST_DSEXAMPLE_REDIS_LAYOUT_BOTH:
+      return StreamLayout::BOTH;
+    case GST_DSEXAMPLE_REDIS_LAYOUT_GLOBAL:
+    default:
+      return StreamLayout::GLOBAL;
+  }
+}
+
+#define GST_TYPE_DSEXAMPLE_REDIS_COMPRESSION \
+    (gst_dsexample_redis_compression_get_type ())
+
+static GType
+gst_dsexample_redis_compression_get_type (void)
+{
+  static GType compression_type = 0;
+  static const GEnumValue compression_values[] = {
+    {GST_DSEXAMPLE_REDIS_COMPRESSION_NONE, "Uncompressed", "none"},
+    {GST_DSEXAMPLE_REDIS_COMPRESSION_ZSTD, "zstd (WITH_ZSTD builds)", "zstd"},
+    {GST_DSEXAMPLE_REDIS_COMPRESSION_LZ4, "lz4 (WITH_LZ4 builds)", "lz4"},
+    {0, NULL, NULL}
+  };
+
+  if (!compression_type) {
+    compression_type = g_enum_register_static ("GstDsExampleRedisCompression",
+        compression_values);
+  }
+  return compression_type;
+}
+
+static VLMCompression
+gst_dsexample_compression (GstDsExampleRedisCompression compression)
+{
+  switch (compression) {
+    case GST_DSEXAMPLE_REDIS_COMPRESSION_ZSTD:
+      return VLMCompression::ZSTD;
+    case GST_DSEXAMPLE_REDIS_COMPRESSION_LZ4:
+      return VLMCompression::LZ4;
+    case GST_DSEXAMPLE_REDIS_COMPRESSION_NONE:
+    default:
+      return VLMCompression::NONE;
+  }
+}
+
+static RedisConnectionOptions
+gst_dsexample_redis_options (GstDsExample * dsexample)
+{
+  RedisConnectionOptions options;
+  if (dsexample->redis_unix_socket && *dsexample->redis_unix_socket)
+    options.unix_socket = dsexample->redis_unix_socket;
+  options.connect_timeout =
+      std::chrono::milliseconds (dsexample->redis_connect_timeout_ms);
+  options.command_timeout =
+      std::chrono::milliseconds (dsexample->redis_command_timeout_ms);
+  options.keepalive = std::chrono::seconds (dsexample->redis_keepalive_sec);
+  options.tcp_nodelay = dsexample->redis_tcp_nodelay;
+  return options;
+}
+
 /* Define our element type. Standard GObject/GStreamer boilerplate stuff */
 #define gst_dsexample_parent_class parent_class
 G_DEFINE_TYPE (GstDsExample, gst_dsexample, GST_TYPE_BASE_TRANSFORM);
@@ -120,6 +332,7 @@ static void gst_dsexample_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_dsexample_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
+static void gst_dsexample_finalize (GObject * object);
 
 static gboolean gst_dsexample_set_caps (GstBaseTransform * btrans,
     GstCaps * incaps, GstCaps * outcaps);
@@ -132,10 +345,19 @@ static GstFlowReturn gst_dsexample_transform_ip (GstBaseTransform *
 static std::shared_ptr<VLMFrameData> 
 create_mock_frame_data(GstDsExample *dsexample, NvDsFrameMeta *frame_meta, guint batch_idx);
 
-static void gst_dsexample_send_to_vlm_service(GstDsExample *dsexample,
-    std::shared_ptr<struct VLMFrameData> frame_data);
+static gboolean gst_dsexample_send_to_vlm_service(GstDsExample *dsexample,
+    const VLMFrameData &frame_data, VLMWorkerStats *stats);
+
+static size_t gst_dsexample_publish_vlm_results (VLMRedisStreamManager *redis,
+    std::vector<VLMPublishItem> &batch);
+
+static void gst_dsexample_drain_vlm_requests (GstDsExample *dsexample);
+
+static void gst_dsexample_vlm_worker (GstDsExample *dsexample, guint worker_id);
 
-static void gst_dsexample_vlm_worker (GstDsExample *dsexample);
+static gboolean gst_dsexample_extract_vlm_frame (GstDsExample *dsexample,
+    NvBufSurface *surface, NvDsFrameMeta *frame_meta, VLMFrameData &vlm_frame,
+    gboolean *unchanged);
 
 /* Install properties, set sink and src pad capabilities, override the required
  * functions of the base class, These are common to all instances of the
@@ -158,6 +380,7 @@ gst_dsexample_class_init (GstDsExampleClass * klass)
   /* Overide base class functions */
   gobject_class->set_property = GST_DEBUG_FUNCPTR (gst_dsexample_set_property);
   gobject_class->get_property = GST_DEBUG_FUNCPTR (gst_dsexample_get_property);
+  gobject_class->finalize = GST_DEBUG_FUNCPTR (gst_dsexample_finalize);
 
   gstbasetransform_class->set_caps = GST_DEBUG_FUNCPTR (gst_dsexample_set_caps);
   gstbasetransform_class->start = GST_DEBUG_FUNCPTR (gst_dsexample_start);
@@ -242,10 +465,385 @@ gst_dsexample_class_init (GstDsExampleClass * klass)
   g_object_class_install_property (gobject_class, PROP_VLM_SERVICE_URL,
       g_param_spec_string ("vlm-service-url",
           "VLM Service URL",
-          "URL endpoint for VLM service",
-          "http://localhost:8000/vlm/analyze", (GParamFlags)
+          "OpenAI-compatible chat/completions endpoint of the VLM backend "
+          "(vLLM, SGLang, Ollama's /v1, ...)",
+          DEFAULT_VLM_SERVICE_URL, (GParamFlags)
           (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
+  g_object_class_install_property (gobject_class, PROP_VLM_MODEL,
+      g_param_spec_string ("vlm-model",
+          "VLM Model",
+          "Model requested from the VLM backend (unset = the server's default)",
+          DEFAULT_VLM_MODEL, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_PROMPT,
+      g_param_spec_string ("vlm-prompt",
+          "VLM Prompt",
+          "Text sent with every frame",
+          DEFAULT_VLM_PROMPT, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_REQUEST_TIMEOUT_MS,
+      g_param_spec_uint ("vlm-request-timeout-ms",
+          "VLM Request Timeout",
+          "Time in milliseconds after which a VLM request is abandoned",
+          100, G_MAXINT, DEFAULT_VLM_REQUEST_TIMEOUT_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_MAX_INFLIGHT,
+      g_param_spec_uint ("vlm-max-inflight",
+          "VLM Max In-Flight Requests",
+          "Requests outstanding at once across all VLM workers; workers wait "
+          "for a free slot beyond this, and connections are reused across "
+          "requests",
+          1, MAX_VLM_MAX_INFLIGHT, DEFAULT_VLM_MAX_INFLIGHT, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_STREAM,
+      g_param_spec_boolean ("vlm-stream",
+          "VLM Streaming",
+          "Request streamed (server-sent event) responses and publish the "
+          "text generated so far to the vlm:results:partial Redis stream "
+          "while the final result is pending",
+          DEFAULT_VLM_STREAM, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_STREAM_FLUSH_TOKENS,
+      g_param_spec_uint ("vlm-stream-flush-tokens",
+          "VLM Stream Flush Tokens",
+          "Publish a partial result every this many streamed tokens",
+          1, G_MAXINT, DEFAULT_VLM_STREAM_FLUSH_TOKENS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_STREAM_FLUSH_MS,
+      g_param_spec_uint ("vlm-stream-flush-ms",
+          "VLM Stream Flush Interval",
+          "Publish a partial result on the first streamed token after this "
+          "many milliseconds without one, even short of "
+          "vlm-stream-flush-tokens",
+          0, G_MAXINT, DEFAULT_VLM_STREAM_FLUSH_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_ADAPTIVE_INTERVAL,
+      g_param_spec_boolean ("vlm-adaptive-interval",
+          "VLM Adaptive Interval",
+          "Adjust each source's sampling interval to the VLM backend's "
+          "capacity (AIMD on latency, queue fill and drops), starting from "
+          "vlm-frame-interval. Posts a \"vlm-sampling\" element message per "
+          "source whenever the intervals are updated",
+          DEFAULT_VLM_ADAPTIVE_INTERVAL, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_MIN_FRAME_INTERVAL,
+      g_param_spec_uint ("vlm-min-frame-interval",
+          "VLM Min Frame Interval",
+          "Densest sampling the adaptive interval may reach (1 = every frame)",
+          1, MAX_VLM_FRAME_INTERVAL, DEFAULT_VLM_MIN_FRAME_INTERVAL, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_MAX_FRAME_INTERVAL,
+      g_param_spec_uint ("vlm-max-frame-interval",
+          "VLM Max Frame Interval",
+          "Sparsest sampling the adaptive interval may reach",
+          1, MAX_VLM_FRAME_INTERVAL, DEFAULT_VLM_MAX_FRAME_INTERVAL, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_TARGET_LATENCY_MS,
+      g_param_spec_uint ("vlm-target-latency-ms",
+          "VLM Target Latency",
+          "Backend latency in milliseconds above which the adaptive interval "
+          "backs off",
+          1, G_MAXINT, DEFAULT_VLM_TARGET_LATENCY_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_SCENE_THRESHOLD,
+      g_param_spec_double ("vlm-scene-threshold",
+          "VLM Scene Change Threshold",
+          "Mean absolute luma difference (0-255) from the last frame sent "
+          "for a source that a sampled frame needs to be sent to the VLM; "
+          "unchanged scenes are skipped (0 = send every sampled frame)",
+          0.0, 255.0, DEFAULT_VLM_SCENE_THRESHOLD, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_SCENE_MAX_STALENESS_MS,
+      g_param_spec_uint ("vlm-scene-max-staleness-ms",
+          "VLM Scene Max Staleness",
+          "Send a sampled frame of a source anyway once this many "
+          "milliseconds have passed since its last one, changed or not "
+          "(0 = only on change)",
+          0, G_MAXINT, DEFAULT_VLM_SCENE_MAX_STALENESS_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_CACHE_SIZE,
+      g_param_spec_uint ("vlm-cache-size",
+          "VLM Result Cache Size",
+          "Responses kept to reuse for frames that look like one already "
+          "sent with the same prompt, published with cached=1 instead of "
+          "asking the VLM again (0 = no cache)",
+          0, G_MAXINT, DEFAULT_VLM_CACHE_SIZE, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_CACHE_MAX_DISTANCE,
+      g_param_spec_uint ("vlm-cache-max-distance",
+          "VLM Result Cache Max Distance",
+          "Bits in which the 64-bit perceptual hashes of two frames may "
+          "differ for one to reuse the other's response (0 = identical "
+          "hashes only)",
+          0, 64, DEFAULT_VLM_CACHE_MAX_DISTANCE, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_CACHE_TTL_SEC,
+      g_param_spec_uint ("vlm-cache-ttl-sec",
+          "VLM Result Cache TTL",
+          "Seconds a cached response may be reused for, locally and in Redis",
+          1, G_MAXINT, DEFAULT_VLM_CACHE_TTL_SEC, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_CACHE_REDIS,
+      g_param_spec_boolean ("vlm-cache-redis",
+          "VLM Result Cache in Redis",
+          "Share cached responses with other nodes through Redis keys "
+          "vlm:cache:*; entries found there match identical hashes only",
+          DEFAULT_VLM_CACHE_REDIS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_QUEUE_POLICY,
+      g_param_spec_enum ("vlm-queue-policy",
+          "VLM Queue Policy",
+          "Queue implementation between the streaming thread and the VLM worker",
+          GST_TYPE_DSEXAMPLE_VLM_QUEUE_POLICY, DEFAULT_VLM_QUEUE_POLICY,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_BATCH_SIZE,
+      g_param_spec_uint ("vlm-batch-size",
+          "VLM Batch Size",
+          "Deprecated and ignored. Every frame is its own chat/completions "
+          "request, and requests are already in flight together up to "
+          "vlm-max-inflight",
+          1, MAX_VLM_BATCH_SIZE, DEFAULT_VLM_BATCH_SIZE, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_DEPRECATED |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_BATCH_TIMEOUT_MS,
+      g_param_spec_uint ("vlm-batch-timeout-ms",
+          "VLM Batch Timeout",
+          "Deprecated and ignored, like vlm-batch-size; workers never wait "
+          "for more frames",
+          0, 10000, DEFAULT_VLM_BATCH_TIMEOUT_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_DEPRECATED)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_SOURCE_QUEUE_SIZE,
+      g_param_spec_uint ("vlm-source-queue-size",
+          "VLM Per-Source Queue Size",
+          "Maximum frames queued per source when vlm-queue-policy=fair",
+          1, 1000, DEFAULT_VLM_SOURCE_QUEUE_SIZE, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_WORKERS,
+      g_param_spec_uint ("vlm-workers",
+          "VLM Workers",
+          "Number of worker threads sending frames to the VLM service "
+          "concurrently",
+          1, MAX_VLM_WORKERS, DEFAULT_VLM_WORKERS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_VLM_SHARED_DISPATCHER,
+      g_param_spec_boolean ("vlm-shared-dispatcher",
+          "VLM Shared Dispatcher",
+          "Submit frames to a process-wide dispatcher shared by all dsexample "
+          "instances instead of a per-element queue, worker pool and Redis "
+          "connection. The dispatcher also owns the only VLM HTTP client and "
+          "Redis publisher. The first instance to start configures it with "
+          "its vlm-workers, vlm-queue-size, vlm-source-queue-size, "
+          "vlm-max-inflight and VLM service settings",
+          DEFAULT_VLM_SHARED_DISPATCHER, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_PIPELINE_SIZE,
+      g_param_spec_uint ("redis-pipeline-size",
+          "Redis Pipeline Size",
+          "Send VLM results to Redis in pipelined batches of up to this many "
+          "XADDs over one extra connection. 0 sends each result in its own "
+          "round trip over a pooled connection",
+          0, MAX_REDIS_PIPELINE_SIZE, DEFAULT_REDIS_PIPELINE_SIZE, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_PIPELINE_FLUSH_US,
+      g_param_spec_uint ("redis-pipeline-flush-us",
+          "Redis Pipeline Flush Interval",
+          "Maximum time in microseconds a pipelined XADD waits for its batch "
+          "to fill before it is sent",
+          1, G_MAXUINT, DEFAULT_REDIS_PIPELINE_FLUSH_US, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_STREAM_MAXLEN,
+      g_param_spec_uint ("redis-stream-maxlen",
+          "Redis Stream Max Length",
+          "Approximate cap (XADD MAXLEN ~) on the number of entries kept in "
+          "the VLM result and frame streams. 0 leaves them unbounded",
+          0, G_MAXUINT, DEFAULT_REDIS_STREAM_MAXLEN, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_RETENTION_SEC,
+      g_param_spec_uint ("redis-retention-sec",
+          "Redis Retention",
+          "Periodically trim stream entries older than this many seconds "
+          "(XTRIM MINID ~). 0 disables the retention task",
+          0, G_MAXUINT, DEFAULT_REDIS_RETENTION_SEC, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class,
+      PROP_REDIS_PENDING_RECOVERY_SEC,
+      g_param_spec_uint ("redis-pending-recovery-sec",
+          "Redis Pending Recovery",
+          "Move VLM results that consumers of the vlm_processors group left "
+          "unacknowledged for this many seconds, after 5 deliveries, to "
+          "vlm:results:deadletter. 0 disables pending recovery",
+          0, G_MAXUINT, DEFAULT_REDIS_PENDING_RECOVERY_SEC, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_STREAM_LAYOUT,
+      g_param_spec_enum ("redis-stream-layout",
+          "Redis Stream Layout",
+          "Write VLM results to the global stream, to per-source streams "
+          "(vlm:results:{<source_id>}) or to both",
+          GST_TYPE_DSEXAMPLE_REDIS_STREAM_LAYOUT, DEFAULT_REDIS_STREAM_LAYOUT,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_CLUSTER,
+      g_param_spec_boolean ("redis-cluster",
+          "Redis Cluster",
+          "Treat the Redis server as a seed node of a Redis Cluster and route "
+          "each stream to the master owning its hash slot. Disables "
+          "redis-pipeline-size",
+          DEFAULT_REDIS_CLUSTER, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_SPILL_DIR,
+      g_param_spec_string ("redis-spill-dir",
+          "Redis Spill Directory",
+          "Directory for an on-disk log of VLM results that could not be "
+          "written while Redis was unreachable; they are replayed in order "
+          "once it is back. Unset drops them",
+          DEFAULT_REDIS_SPILL_DIR, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_SPILL_MAX_MB,
+      g_param_spec_uint ("redis-spill-max-mb",
+          "Redis Spill Size Limit",
+          "Maximum size of the spill log in MiB; results spilled beyond it "
+          "are dropped",
+          8, G_MAXUINT, DEFAULT_REDIS_SPILL_MAX_MB, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_COMPACT,
+      g_param_spec_boolean ("redis-compact",
+          "Redis Compact Entries",
+          "Write each VLM result as a single MessagePack field with an "
+          "interned model name (vlm:models) instead of six string fields",
+          DEFAULT_REDIS_COMPACT, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_COMPRESSION,
+      g_param_spec_enum ("redis-compression",
+          "Redis Compression",
+          "Compress VLM responses of compact entries that are at least 512 "
+          "bytes long (REDIS_COMPRESS_MIN_BYTES)",
+          GST_TYPE_DSEXAMPLE_REDIS_COMPRESSION, DEFAULT_REDIS_COMPRESSION,
+          (GParamFlags) (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_HOST,
+      g_param_spec_string ("redis-host",
+          "Redis Host",
+          "Redis server (or cluster seed node) host name or address",
+          DEFAULT_REDIS_HOST, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_PORT,
+      g_param_spec_uint ("redis-port",
+          "Redis Port",
+          "Redis server (or cluster seed node) TCP port",
+          1, 65535, DEFAULT_REDIS_PORT, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_UNIX_SOCKET,
+      g_param_spec_string ("redis-unix-socket",
+          "Redis Unix Socket",
+          "Path of a co-located Redis server's Unix socket; used instead of "
+          "redis-host/redis-port when set (not in cluster mode)",
+          DEFAULT_REDIS_UNIX_SOCKET, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_CONNECT_TIMEOUT_MS,
+      g_param_spec_uint ("redis-connect-timeout-ms",
+          "Redis Connect Timeout",
+          "Bound on each connection attempt in milliseconds (0 = OS default)",
+          0, G_MAXUINT, DEFAULT_REDIS_CONNECT_TIMEOUT_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_COMMAND_TIMEOUT_MS,
+      g_param_spec_uint ("redis-command-timeout-ms",
+          "Redis Command Timeout",
+          "Time to wait for a reply in milliseconds before the connection is "
+          "dropped and reopened; blocking reads get their BLOCK time on top. "
+          "0 waits indefinitely",
+          0, G_MAXUINT, DEFAULT_REDIS_COMMAND_TIMEOUT_MS, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_KEEPALIVE_SEC,
+      g_param_spec_uint ("redis-keepalive-sec",
+          "Redis TCP Keepalive",
+          "TCP keepalive interval in seconds for Redis connections (0 = off)",
+          0, G_MAXINT, DEFAULT_REDIS_KEEPALIVE_SEC, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
+  g_object_class_install_property (gobject_class, PROP_REDIS_TCP_NODELAY,
+      g_param_spec_boolean ("redis-tcp-nodelay",
+          "Redis TCP_NODELAY",
+          "Disable Nagle's algorithm on Redis TCP connections",
+          DEFAULT_REDIS_TCP_NODELAY, (GParamFlags)
+          (G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+              GST_PARAM_MUTABLE_READY)));
+
   /* Set sink and src pad capabilities */
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_dsexample_src_template));
@@ -285,21 +883,66 @@ gst_dsexample_init (GstDsExample * dsexample)
   // Initialize VLM queue and threading
   dsexample->vlm_enabled = TRUE;
   dsexample->vlm_thread_running = false;
-  dsexample->vlm_frame_queue = std::make_shared<ThreadSafeQueue<VLMFrameData>>();
+  dsexample->vlm_queue_policy = DEFAULT_VLM_QUEUE_POLICY;
+  dsexample->vlm_frame_queue = nullptr;  // Created in start, sized from vlm-queue-size
 
   dsexample->vlm_queue_max_size = 100;      // Maximum 100 frames in queue
+  dsexample->vlm_source_queue_size = DEFAULT_VLM_SOURCE_QUEUE_SIZE;
   dsexample->vlm_frame_interval = 30;       // Process every 30th frame
+  dsexample->vlm_workers = DEFAULT_VLM_WORKERS;
+  dsexample->vlm_batch_size = DEFAULT_VLM_BATCH_SIZE;
+  dsexample->vlm_batch_timeout_ms = DEFAULT_VLM_BATCH_TIMEOUT_MS;
   dsexample->vlm_frame_counter = 0;
-  dsexample->vlm_service_url = g_strdup("http://localhost:8000/vlm/analyze");  // Default URL
+  dsexample->vlm_frames_dropped = 0;
+  dsexample->vlm_service_url = g_strdup(DEFAULT_VLM_SERVICE_URL);
+  dsexample->vlm_model = DEFAULT_VLM_MODEL;
+  dsexample->vlm_prompt = g_strdup (DEFAULT_VLM_PROMPT);
+  dsexample->vlm_request_timeout_ms = DEFAULT_VLM_REQUEST_TIMEOUT_MS;
+  dsexample->vlm_max_inflight = DEFAULT_VLM_MAX_INFLIGHT;
+  dsexample->vlm_stream = DEFAULT_VLM_STREAM;
+  dsexample->vlm_stream_flush_tokens = DEFAULT_VLM_STREAM_FLUSH_TOKENS;
+  dsexample->vlm_stream_flush_ms = DEFAULT_VLM_STREAM_FLUSH_MS;
+  dsexample->vlm_adaptive_interval = DEFAULT_VLM_ADAPTIVE_INTERVAL;
+  dsexample->vlm_min_frame_interval = DEFAULT_VLM_MIN_FRAME_INTERVAL;
+  dsexample->vlm_max_frame_interval = DEFAULT_VLM_MAX_FRAME_INTERVAL;
+  dsexample->vlm_target_latency_ms = DEFAULT_VLM_TARGET_LATENCY_MS;
+  dsexample->vlm_rate_controller = nullptr;  // Created in start
+  dsexample->vlm_scene_threshold = DEFAULT_VLM_SCENE_THRESHOLD;
+  dsexample->vlm_scene_max_staleness_ms = DEFAULT_VLM_SCENE_MAX_STALENESS_MS;
+  dsexample->vlm_scene_state = nullptr;  // Created in start
+  dsexample->vlm_frames_unchanged = 0;
+  dsexample->vlm_cache_size = DEFAULT_VLM_CACHE_SIZE;
+  dsexample->vlm_cache_max_distance = DEFAULT_VLM_CACHE_MAX_DISTANCE;
+  dsexample->vlm_cache_ttl_sec = DEFAULT_VLM_CACHE_TTL_SEC;
+  dsexample->vlm_cache_redis = DEFAULT_VLM_CACHE_REDIS;
+  dsexample->vlm_result_cache = nullptr;  // Created in start
+  dsexample->vlm_http_client = nullptr;  // Created in start
+  dsexample->vlm_publisher = nullptr;  // Created in start
+
+  dsexample->vlm_shared_dispatcher = DEFAULT_VLM_SHARED_DISPATCHER;
+  dsexample->vlm_dispatcher = nullptr;
+  dsexample->vlm_dispatcher_client = nullptr;
 
   dsexample->redis_enabled = TRUE;
-  dsexample->vlm_stream_manager = std::make_shared<VLMRedisStreamManager>("localhost", 6379);
-    
-  if (dsexample->vlm_stream_manager->is_connected()) {
-      g_print("✅ VLM Redis Streams ready\n");
-  } else {
-      g_print("❌ VLM Redis Streams connection failed\n");
-  }
+  dsexample->vlm_stream_manager = nullptr;  // Connected in start
+  dsexample->redis_pipeline_size = DEFAULT_REDIS_PIPELINE_SIZE;
+  dsexample->redis_pipeline_flush_us = DEFAULT_REDIS_PIPELINE_FLUSH_US;
+  dsexample->redis_stream_maxlen = DEFAULT_REDIS_STREAM_MAXLEN;
+  dsexample->redis_retention_sec = DEFAULT_REDIS_RETENTION_SEC;
+  dsexample->redis_pending_recovery_sec = DEFAULT_REDIS_PENDING_RECOVERY_SEC;
+  dsexample->redis_stream_layout = DEFAULT_REDIS_STREAM_LAYOUT;
+  dsexample->redis_cluster = DEFAULT_REDIS_CLUSTER;
+  dsexample->redis_spill_dir = DEFAULT_REDIS_SPILL_DIR;
+  dsexample->redis_spill_max_mb = DEFAULT_REDIS_SPILL_MAX_MB;
+  dsexample->redis_compact = DEFAULT_REDIS_COMPACT;
+  dsexample->redis_compression = DEFAULT_REDIS_COMPRESSION;
+  dsexample->redis_host = g_strdup (DEFAULT_REDIS_HOST);
+  dsexample->redis_port = DEFAULT_REDIS_PORT;
+  dsexample->redis_unix_socket = DEFAULT_REDIS_UNIX_SOCKET;
+  dsexample->redis_connect_timeout_ms = DEFAULT_REDIS_CONNECT_TIMEOUT_MS;
+  dsexample->redis_command_timeout_ms = DEFAULT_REDIS_COMMAND_TIMEOUT_MS;
+  dsexample->redis_keepalive_sec = DEFAULT_REDIS_KEEPALIVE_SEC;
+  dsexample->redis_tcp_nodelay = DEFAULT_REDIS_TCP_NODELAY;
 
   /* This quark is required to identify NvDsMeta when iterating through
    * the buffer metadatas */
@@ -351,6 +994,140 @@ gst_dsexample_set_property (GObject * object, guint prop_id,
       }
       dsexample->vlm_service_url = g_value_dup_string (value);
       break;
+    case PROP_VLM_QUEUE_POLICY:
+      dsexample->vlm_queue_policy =
+          (GstDsExampleVlmQueuePolicy) g_value_get_enum (value);
+      break;
+    case PROP_VLM_BATCH_SIZE:
+      dsexample->vlm_batch_size = g_value_get_uint (value);
+      if (dsexample->vlm_batch_size > 1)
+        GST_WARNING_OBJECT (dsexample, "vlm-batch-size is deprecated and "
+            "ignored; frames are sent one per request");
+      break;
+    case PROP_VLM_BATCH_TIMEOUT_MS:
+      dsexample->vlm_batch_timeout_ms = g_value_get_uint (value);
+      break;
+    case PROP_VLM_SOURCE_QUEUE_SIZE:
+      dsexample->vlm_source_queue_size = g_value_get_uint (value);
+      break;
+    case PROP_VLM_WORKERS:
+      dsexample->vlm_workers = g_value_get_uint (value);
+      break;
+    case PROP_VLM_SHARED_DISPATCHER:
+      dsexample->vlm_shared_dispatcher = g_value_get_boolean (value);
+      break;
+    case PROP_REDIS_PIPELINE_SIZE:
+      dsexample->redis_pipeline_size = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_PIPELINE_FLUSH_US:
+      dsexample->redis_pipeline_flush_us = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_STREAM_MAXLEN:
+      dsexample->redis_stream_maxlen = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_RETENTION_SEC:
+      dsexample->redis_retention_sec = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_PENDING_RECOVERY_SEC:
+      dsexample->redis_pending_recovery_sec = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_STREAM_LAYOUT:
+      dsexample->redis_stream_layout =
+          (GstDsExampleRedisStreamLayout) g_value_get_enum (value);
+      break;
+    case PROP_REDIS_CLUSTER:
+      dsexample->redis_cluster = g_value_get_boolean (value);
+      break;
+    case PROP_REDIS_SPILL_DIR:
+      g_free (dsexample->redis_spill_dir);
+      dsexample->redis_spill_dir = g_value_dup_string (value);
+      break;
+    case PROP_REDIS_SPILL_MAX_MB:
+      dsexample->redis_spill_max_mb = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_COMPACT:
+      dsexample->redis_compact = g_value_get_boolean (value);
+      break;
+    case PROP_REDIS_COMPRESSION:
+      dsexample->redis_compression =
+          (GstDsExampleRedisCompression) g_value_get_enum (value);
+      break;
+    case PROP_REDIS_HOST:
+      g_free (dsexample->redis_host);
+      dsexample->redis_host = g_value_dup_string (value);
+      break;
+    case PROP_REDIS_PORT:
+      dsexample->redis_port = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_UNIX_SOCKET:
+      g_free (dsexample->redis_unix_socket);
+      dsexample->redis_unix_socket = g_value_dup_string (value);
+      break;
+    case PROP_REDIS_CONNECT_TIMEOUT_MS:
+      dsexample->redis_connect_timeout_ms = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_COMMAND_TIMEOUT_MS:
+      dsexample->redis_command_timeout_ms = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_KEEPALIVE_SEC:
+      dsexample->redis_keepalive_sec = g_value_get_uint (value);
+      break;
+    case PROP_REDIS_TCP_NODELAY:
+      dsexample->redis_tcp_nodelay = g_value_get_boolean (value);
+      break;
+    case PROP_VLM_MODEL:
+      g_free (dsexample->vlm_model);
+      dsexample->vlm_model = g_value_dup_string (value);
+      break;
+    case PROP_VLM_PROMPT:
+      g_free (dsexample->vlm_prompt);
+      dsexample->vlm_prompt = g_value_dup_string (value);
+      break;
+    case PROP_VLM_REQUEST_TIMEOUT_MS:
+      dsexample->vlm_request_timeout_ms = g_value_get_uint (value);
+      break;
+    case PROP_VLM_MAX_INFLIGHT:
+      dsexample->vlm_max_inflight = g_value_get_uint (value);
+      break;
+    case PROP_VLM_STREAM:
+      dsexample->vlm_stream = g_value_get_boolean (value);
+      break;
+    case PROP_VLM_STREAM_FLUSH_TOKENS:
+      dsexample->vlm_stream_flush_tokens = g_value_get_uint (value);
+      break;
+    case PROP_VLM_STREAM_FLUSH_MS:
+      dsexample->vlm_stream_flush_ms = g_value_get_uint (value);
+      break;
+    case PROP_VLM_ADAPTIVE_INTERVAL:
+      dsexample->vlm_adaptive_interval = g_value_get_boolean (value);
+      break;
+    case PROP_VLM_MIN_FRAME_INTERVAL:
+      dsexample->vlm_min_frame_interval = g_value_get_uint (value);
+      break;
+    case PROP_VLM_MAX_FRAME_INTERVAL:
+      dsexample->vlm_max_frame_interval = g_value_get_uint (value);
+      break;
+    case PROP_VLM_TARGET_LATENCY_MS:
+      dsexample->vlm_target_latency_ms = g_value_get_uint (value);
+      break;
+    case PROP_VLM_SCENE_THRESHOLD:
+      dsexample->vlm_scene_threshold = g_value_get_double (value);
+      break;
+    case PROP_VLM_SCENE_MAX_STALENESS_MS:
+      dsexample->vlm_scene_max_staleness_ms = g_value_get_uint (value);
+      break;
+    case PROP_VLM_CACHE_SIZE:
+      dsexample->vlm_cache_size = g_value_get_uint (value);
+      break;
+    case PROP_VLM_CACHE_MAX_DISTANCE:
+      dsexample->vlm_cache_max_distance = g_value_get_uint (value);
+      break;
+    case PROP_VLM_CACHE_TTL_SEC:
+      dsexample->vlm_cache_ttl_sec = g_value_get_uint (value);
+      break;
+    case PROP_VLM_CACHE_REDIS:
+      dsexample->vlm_cache_redis = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -400,12 +1177,151 @@ gst_dsexample_get_property (GObject * object, guint prop_id,
     case PROP_VLM_SERVICE_URL:
       g_value_set_string (value, dsexample->vlm_service_url);
       break;
+    case PROP_VLM_QUEUE_POLICY:
+      g_value_set_enum (value, dsexample->vlm_queue_policy);
+      break;
+    case PROP_VLM_BATCH_SIZE:
+      g_value_set_uint (value, dsexample->vlm_batch_size);
+      break;
+    case PROP_VLM_BATCH_TIMEOUT_MS:
+      g_value_set_uint (value, dsexample->vlm_batch_timeout_ms);
+      break;
+    case PROP_VLM_SOURCE_QUEUE_SIZE:
+      g_value_set_uint (value, dsexample->vlm_source_queue_size);
+      break;
+    case PROP_VLM_WORKERS:
+      g_value_set_uint (value, dsexample->vlm_workers);
+      break;
+    case PROP_VLM_SHARED_DISPATCHER:
+      g_value_set_boolean (value, dsexample->vlm_shared_dispatcher);
+      break;
+    case PROP_REDIS_PIPELINE_SIZE:
+      g_value_set_uint (value, dsexample->redis_pipeline_size);
+      break;
+    case PROP_REDIS_PIPELINE_FLUSH_US:
+      g_value_set_uint (value, dsexample->redis_pipeline_flush_us);
+      break;
+    case PROP_REDIS_STREAM_MAXLEN:
+      g_value_set_uint (value, dsexample->redis_stream_maxlen);
+      break;
+    case PROP_REDIS_RETENTION_SEC:
+      g_value_set_uint (value, dsexample->redis_retention_sec);
+      break;
+    case PROP_REDIS_PENDING_RECOVERY_SEC:
+      g_value_set_uint (value, dsexample->redis_pending_recovery_sec);
+      break;
+    case PROP_REDIS_STREAM_LAYOUT:
+      g_value_set_enum (value, dsexample->redis_stream_layout);
+      break;
+    case PROP_REDIS_CLUSTER:
+      g_value_set_boolean (value, dsexample->redis_cluster);
+      break;
+    case PROP_REDIS_SPILL_DIR:
+      g_value_set_string (value, dsexample->redis_spill_dir);
+      break;
+    case PROP_REDIS_SPILL_MAX_MB:
+      g_value_set_uint (value, dsexample->redis_spill_max_mb);
+      break;
+    case PROP_REDIS_COMPACT:
+      g_value_set_boolean (value, dsexample->redis_compact);
+      break;
+    case PROP_REDIS_COMPRESSION:
+      g_value_set_enum (value, dsexample->redis_compression);
+      break;
+    case PROP_REDIS_HOST:
+      g_value_set_string (value, dsexample->redis_host);
+      break;
+    case PROP_REDIS_PORT:
+      g_value_set_uint (value, dsexample->redis_port);
+      break;
+    case PROP_REDIS_UNIX_SOCKET:
+      g_value_set_string (value, dsexample->redis_unix_socket);
+      break;
+    case PROP_REDIS_CONNECT_TIMEOUT_MS:
+      g_value_set_uint (value, dsexample->redis_connect_timeout_ms);
+      break;
+    case PROP_REDIS_COMMAND_TIMEOUT_MS:
+      g_value_set_uint (value, dsexample->redis_command_timeout_ms);
+      break;
+    case PROP_REDIS_KEEPALIVE_SEC:
+      g_value_set_uint (value, dsexample->redis_keepalive_sec);
+      break;
+    case PROP_REDIS_TCP_NODELAY:
+      g_value_set_boolean (value, dsexample->redis_tcp_nodelay);
+      break;
+    case PROP_VLM_MODEL:
+      g_value_set_string (value, dsexample->vlm_model);
+      break;
+    case PROP_VLM_PROMPT:
+      g_value_set_string (value, dsexample->vlm_prompt);
+      break;
+    case PROP_VLM_REQUEST_TIMEOUT_MS:
+      g_value_set_uint (value, dsexample->vlm_request_timeout_ms);
+      break;
+    case PROP_VLM_MAX_INFLIGHT:
+      g_value_set_uint (value, dsexample->vlm_max_inflight);
+      break;
+    case PROP_VLM_STREAM:
+      g_value_set_boolean (value, dsexample->vlm_stream);
+      break;
+    case PROP_VLM_STREAM_FLUSH_TOKENS:
+      g_value_set_uint (value, dsexample->vlm_stream_flush_tokens);
+      break;
+    case PROP_VLM_STREAM_FLUSH_MS:
+      g_value_set_uint (value, dsexample->vlm_stream_flush_ms);
+      break;
+    case PROP_VLM_ADAPTIVE_INTERVAL:
+      g_value_set_boolean (value, dsexample->vlm_adaptive_interval);
+      break;
+    case PROP_VLM_MIN_FRAME_INTERVAL:
+      g_value_set_uint (value, dsexample->vlm_min_frame_interval);
+      break;
+    case PROP_VLM_MAX_FRAME_INTERVAL:
+      g_value_set_uint (value, dsexample->vlm_max_frame_interval);
+      break;
+    case PROP_VLM_TARGET_LATENCY_MS:
+      g_value_set_uint (value, dsexample->vlm_target_latency_ms);
+      break;
+    case PROP_VLM_SCENE_THRESHOLD:
+      g_value_set_double (value, dsexample->vlm_scene_threshold);
+      break;
+    case PROP_VLM_SCENE_MAX_STALENESS_MS:
+      g_value_set_uint (value, dsexample->vlm_scene_max_staleness_ms);
+      break;
+    case PROP_VLM_CACHE_SIZE:
+      g_value_set_uint (value, dsexample->vlm_cache_size);
+      break;
+    case PROP_VLM_CACHE_MAX_DISTANCE:
+      g_value_set_uint (value, dsexample->vlm_cache_max_distance);
+      break;
+    case PROP_VLM_CACHE_TTL_SEC:
+      g_value_set_uint (value, dsexample->vlm_cache_ttl_sec);
+      break;
+    case PROP_VLM_CACHE_REDIS:
+      g_value_set_boolean (value, dsexample->vlm_cache_redis);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* Free the string properties */
+static void
+gst_dsexample_finalize (GObject * object)
+{
+  GstDsExample *dsexample = GST_DSEXAMPLE (object);
+
+  g_free (dsexample->vlm_service_url);
+  g_free (dsexample->vlm_model);
+  g_free (dsexample->vlm_prompt);
+  g_free (dsexample->redis_host);
+  g_free (dsexample->redis_unix_socket);
+  g_free (dsexample->redis_spill_dir);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 /**
  * Initialize all resources and start the output thread
  */
@@ -504,12 +1420,221 @@ gst_dsexample_start (GstBaseTransform * btrans)
   dsexample->transform_config_params.compute_mode =
       NvBufSurfTransformCompute_Default;
   dsexample->transform_config_params.gpu_id = dsexample->gpu_id;
+  dsexample->transform_config_params.cuda_stream = dsexample->cuda_stream;
   
 
   // Start VLM worker thread
   if (dsexample->vlm_enabled) {
+    /* Enough buffers for a full queue, one frame being sent per worker and
+     * the frame being filled. Misses fall back to the heap and are counted. */
+    dsexample->vlm_buffer_pool = std::make_shared<FrameBufferPool>(
+        (size_t) dsexample->processing_width * dsexample->processing_height *
+        RGBA_BYTES_PER_PIXEL,
+        dsexample->vlm_queue_max_size + dsexample->vlm_workers + 1);
+
+    VLMHttpClientConfig http_config;
+    http_config.url = dsexample->vlm_service_url ?
+        dsexample->vlm_service_url : DEFAULT_VLM_SERVICE_URL;
+    if (dsexample->vlm_model)
+      http_config.model = dsexample->vlm_model;
+    if (dsexample->vlm_prompt)
+      http_config.prompt = dsexample->vlm_prompt;
+    if (g_getenv ("VLM_API_KEY"))
+      http_config.api_key = g_getenv ("VLM_API_KEY");
+    http_config.request_timeout =
+        std::chrono::milliseconds (dsexample->vlm_request_timeout_ms);
+    http_config.max_inflight = dsexample->vlm_max_inflight;
+    http_config.stream = dsexample->vlm_stream;
+    http_config.stream_flush_tokens = dsexample->vlm_stream_flush_tokens;
+    http_config.stream_flush_interval =
+        std::chrono::milliseconds (dsexample->vlm_stream_flush_ms);
+
+    if (dsexample->vlm_adaptive_interval) {
+      VLMRateControllerConfig rate_config;
+      rate_config.min_interval = dsexample->vlm_min_frame_interval;
+      rate_config.max_interval = MAX (dsexample->vlm_min_frame_interval,
+          dsexample->vlm_max_frame_interval);
+      rate_config.initial_interval = dsexample->vlm_frame_interval;
+      rate_config.target_latency =
+          std::chrono::milliseconds (dsexample->vlm_target_latency_ms);
+      dsexample->vlm_rate_controller =
+          std::make_shared<VLMRateController> (rate_config);
+    }
+
+    dsexample->vlm_frames_unchanged = 0;
+    if (dsexample->vlm_scene_threshold > 0) {
+      dsexample->vlm_scene_state = std::make_shared<VLMSceneStateMap> ();
+      GST_INFO_OBJECT (dsexample, "VLM scene-change gate: threshold %.1f, "
+          "%s SAD kernel", dsexample->vlm_scene_threshold, SceneSADKernel ());
+    }
+
+    dsexample->vlm_cache_remote_hits = 0;
+    if (dsexample->vlm_cache_size > 0) {
+      VLMResultCacheConfig cache_config;
+      cache_config.capacity = dsexample->vlm_cache_size;
+      cache_config.max_distance = dsexample->vlm_cache_max_distance;
+      cache_config.ttl = std::chrono::seconds (dsexample->vlm_cache_ttl_sec);
+      dsexample->vlm_result_cache =
+          std::make_shared<VLMResultCache> (cache_config);
+      dsexample->vlm_cache_prompt_key =
+          vlm_prompt_key (http_config.prompt, http_config.model);
+    }
+
+    if (dsexample->vlm_shared_dispatcher) {
+      /* Queue, workers, HTTP client, publisher and Redis connections are
+       * owned by the dispatcher and shared with every other instance in
+       * the process */
+      VLMDispatcherConfig config;
+      config.workers = dsexample->vlm_workers;
+      config.queue_size = dsexample->vlm_queue_max_size;
+      config.max_per_source = dsexample->vlm_source_queue_size;
+      config.redis_connections =
+          dsexample->redis_enabled ? dsexample->vlm_workers : 0;
+      config.redis_host =
+          dsexample->redis_host ? dsexample->redis_host : DEFAULT_REDIS_HOST;
+      config.redis_port = dsexample->redis_port;
+      config.redis_options = gst_dsexample_redis_options (dsexample);
+      config.redis_pipeline_size = dsexample->redis_pipeline_size;
+      config.redis_pipeline_flush =
+          std::chrono::microseconds (dsexample->redis_pipeline_flush_us);
+      config.redis_stream_maxlen = dsexample->redis_stream_maxlen;
+      config.redis_retention =
+          std::chrono::seconds (dsexample->redis_retention_sec);
+      config.redis_pending_idle =
+          std::chrono::seconds (dsexample->redis_pending_recovery_sec);
+      config.redis_stream_layout =
+          gst_dsexample_stream_layout (dsexample->redis_stream_layout);
+      config.redis_cluster = dsexample->redis_cluster;
+      if (dsexample->redis_spill_dir) {
+        config.redis_spill_dir = dsexample->redis_spill_dir;
+        config.redis_spill_max_bytes =
+            (size_t) dsexample->redis_spill_max_mb << 20;
+      }
+      config.redis_compact = dsexample->redis_compact;
+      config.redis_compression =
+          gst_dsexample_compression (dsexample->redis_compression);
+      config.redis_compress_min_bytes = REDIS_COMPRESS_MIN_BYTES;
+      config.http = http_config;
+      config.publish_results = gst_dsexample_publish_vlm_results;
+      dsexample->vlm_frames_dropped = 0;
+      dsexample->vlm_dispatcher =
+          VLMDispatcher<VLMFrameData>::acquire (config);
+      /* Aliases: they keep the dispatcher alive, not a client of our own */
+      dsexample->vlm_http_client = std::shared_ptr<VLMHttpClient> (
+          dsexample->vlm_dispatcher,
+          &dsexample->vlm_dispatcher->http_client ());
+      if (dsexample->vlm_dispatcher->publisher ())
+        dsexample->vlm_publisher = std::shared_ptr<VLMResultPublisher> (
+            dsexample->vlm_dispatcher,
+            dsexample->vlm_dispatcher->publisher ());
+      dsexample->vlm_dispatcher_client =
+          dsexample->vlm_dispatcher->register_client (
+              [dsexample] (const VLMFrameData &frame) -> bool {
+                return gst_dsexample_send_to_vlm_service (dsexample, frame,
+                    nullptr);
+              });
+      return TRUE;
+    }
+
+    /* One client for all workers: its I/O thread keeps up to
+     * vlm-max-inflight requests on reused connections */
+    dsexample->vlm_http_client = std::make_shared<VLMHttpClient> (http_config);
+
+    /* Results are written to Redis on a thread of their own, never on the
+     * HTTP client's I/O thread */
+    if (dsexample->redis_enabled)
+      dsexample->vlm_publisher = std::make_shared<VLMResultPublisher> (
+          [dsexample] (std::vector<VLMPublishItem> &batch) {
+            if (!dsexample->vlm_stream_manager)
+              return batch.size ();
+            return gst_dsexample_publish_vlm_results (
+                dsexample->vlm_stream_manager.get (), batch);
+          });
+
+    if (dsexample->redis_enabled) {
+      dsexample->vlm_stream_manager =
+          std::make_shared<VLMRedisStreamManager>(
+              dsexample->redis_host ? dsexample->redis_host : DEFAULT_REDIS_HOST,
+              dsexample->redis_port, dsexample->vlm_workers,
+              dsexample->redis_cluster,
+              gst_dsexample_redis_options (dsexample));
+      dsexample->vlm_stream_manager->enable_pipelining(
+          dsexample->redis_pipeline_size,
+          std::chrono::microseconds (dsexample->redis_pipeline_flush_us));
+      if (dsexample->redis_stream_maxlen > 0) {
+        StreamTrim trim =
+            StreamTrim::max_length (dsexample->redis_stream_maxlen);
+        dsexample->vlm_stream_manager->set_stream_trim (trim, trim);
+      }
+      dsexample->vlm_stream_manager->set_stream_layout (
+          gst_dsexample_stream_layout (dsexample->redis_stream_layout));
+      dsexample->vlm_stream_manager->start_retention (
+          std::chrono::seconds (dsexample->redis_retention_sec),
+          std::chrono::milliseconds (REDIS_RETENTION_INTERVAL_MS));
+      if (dsexample->redis_pending_recovery_sec > 0) {
+        /* Results are only published here, so entries are dead-lettered
+         * but never claimed */
+        PendingRecovery recovery;
+        recovery.min_idle =
+            std::chrono::seconds (dsexample->redis_pending_recovery_sec);
+        recovery.interval =
+            std::chrono::milliseconds (REDIS_PENDING_RECOVERY_INTERVAL_MS);
+        recovery.claim = false;
+        dsexample->vlm_stream_manager->start_pending_recovery (recovery);
+      }
+      if (dsexample->redis_spill_dir) {
+        dsexample->vlm_stream_manager->enable_spill (
+            dsexample->redis_spill_dir,
+            (size_t) dsexample->redis_spill_max_mb << 20);
+      }
+      if (dsexample->redis_compact) {
+        dsexample->vlm_stream_manager->enable_compact_encoding (
+            gst_dsexample_compression (dsexample->redis_compression),
+            REDIS_COMPRESS_MIN_BYTES);
+      }
+      if (dsexample->vlm_stream_manager->is_connected()) {
+          g_print("✅ VLM Redis Streams ready\n");
+      } else {
+          g_print("❌ VLM Redis Streams connection failed\n");
+      }
+    }
+
+    switch (dsexample->vlm_queue_policy) {
+      case GST_DSEXAMPLE_VLM_QUEUE_LOCKFREE:
+        dsexample->vlm_frame_queue =
+            std::make_shared<LockFreeFrameQueue<VLMFrameData>>(
+                dsexample->vlm_queue_max_size);
+        break;
+      case GST_DSEXAMPLE_VLM_QUEUE_FAIR:
+        dsexample->vlm_frame_queue =
+            std::make_shared<FairFrameQueue<VLMFrameData>>(
+                dsexample->vlm_queue_max_size,
+                dsexample->vlm_source_queue_size);
+        break;
+      case GST_DSEXAMPLE_VLM_QUEUE_LATEST:
+        dsexample->vlm_frame_queue =
+            std::make_shared<LatestFrameQueue<VLMFrameData>>(
+                dsexample->vlm_queue_max_size);
+        break;
+      case GST_DSEXAMPLE_VLM_QUEUE_FIFO:
+      default:
+        dsexample->vlm_frame_queue =
+            std::make_shared<MutexFrameQueue<VLMFrameData>>(
+                dsexample->vlm_queue_max_size);
+        break;
+    }
+    dsexample->vlm_frames_dropped = 0;
     dsexample->vlm_thread_running = true;
-    dsexample->vlm_worker_thread = std::thread(gst_dsexample_vlm_worker, dsexample);
+    dsexample->vlm_worker_stats.clear ();
+    dsexample->vlm_worker_threads.clear ();
+    for (guint i = 0; i < dsexample->vlm_workers; i++) {
+      dsexample->vlm_worker_stats.push_back (
+          std::unique_ptr<VLMWorkerStats> (new VLMWorkerStats ()));
+    }
+    for (guint i = 0; i < dsexample->vlm_workers; i++) {
+      dsexample->vlm_worker_threads.emplace_back (gst_dsexample_vlm_worker,
+          dsexample, i);
+    }
   }
 
   return TRUE;
@@ -536,17 +1661,138 @@ gst_dsexample_stop (GstBaseTransform * btrans)
 {
   GstDsExample *dsexample = GST_DSEXAMPLE (btrans);
 
+  // Detach from the shared dispatcher; waits for this element's in-flight
+  // frames and requests. Its results may still be queued on the shared
+  // publisher, which outlives us. The dispatcher itself goes away with its
+  // last client.
+  if (dsexample->vlm_dispatcher) {
+    dsexample->vlm_dispatcher->unregister_client (
+        dsexample->vlm_dispatcher_client);
+    dsexample->vlm_http_client = nullptr;
+    dsexample->vlm_publisher = nullptr;
+    GST_INFO_OBJECT (dsexample, "VLM dispatcher dropped %" G_GUINT64_FORMAT
+        " frames from this source", (guint64) dsexample->vlm_frames_dropped.load ());
+    dsexample->vlm_dispatcher_client = nullptr;
+    dsexample->vlm_dispatcher = nullptr;
+  }
+
   // ✅ FIX: Stop VLM worker thread FIRST
   if (dsexample->vlm_enabled && dsexample->vlm_thread_running) {
-    g_print("Stopping VLM worker thread...\n");
+    g_print("Stopping %zu VLM worker thread(s)...\n",
+        dsexample->vlm_worker_threads.size ());
     
     dsexample->vlm_thread_running = false;
-    dsexample->vlm_frame_queue->terminate();  // ✅ Safe shutdown!
+    dsexample->vlm_frame_queue->terminate();  // ✅ Safe shutdown! Wakes every worker
     
-    if (dsexample->vlm_worker_thread.joinable()) {
-      dsexample->vlm_worker_thread.join();
+    for (auto &worker : dsexample->vlm_worker_threads) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+    dsexample->vlm_worker_threads.clear ();
+    gst_dsexample_drain_vlm_requests (dsexample);
+
+    for (size_t i = 0; i < dsexample->vlm_worker_stats.size (); i++) {
+      const VLMWorkerStats &stats = *dsexample->vlm_worker_stats[i];
+      g_print ("VLM worker %zu: frames=%llu cache_hits=%llu requests=%llu "
+          "failures=%llu busy=%.1f s\n", i,
+          (unsigned long long) stats.frames.load (),
+          (unsigned long long) stats.cache_hits.load (),
+          (unsigned long long) stats.requests.load (),
+          (unsigned long long) stats.failures.load (),
+          stats.busy_us.load () / 1e6);
     }
+    GST_INFO_OBJECT (dsexample, "VLM queue dropped %" G_GUINT64_FORMAT
+        " frames", (guint64) dsexample->vlm_frames_dropped.load ());
   }
+  dsexample->vlm_frame_queue = nullptr;
+
+  if (dsexample->vlm_rate_controller) {
+    VLMRateController::Stats stats = dsexample->vlm_rate_controller->stats ();
+    g_print ("VLM adaptive interval: %llu updates, %llu increases, "
+        "%llu decreases, latency=%.0f ms\n", (unsigned long long) stats.updates,
+        (unsigned long long) stats.increases,
+        (unsigned long long) stats.decreases, stats.latency_ms);
+    for (const VLMRateController::SourceRate &rate :
+        dsexample->vlm_rate_controller->rates ()) {
+      g_print ("  source %u: interval=%.1f frames, %.2f samples/s\n",
+          rate.source_id, rate.interval, rate.sample_rate);
+    }
+  }
+  dsexample->vlm_rate_controller = nullptr;
+
+  if (dsexample->vlm_scene_state) {
+    g_print ("VLM scene-change gate: %llu unchanged frames skipped\n",
+        (unsigned long long) dsexample->vlm_frames_unchanged);
+  }
+  dsexample->vlm_scene_state = nullptr;
+
+  if (dsexample->vlm_result_cache) {
+    VLMResultCache::Stats stats = dsexample->vlm_result_cache->stats ();
+    g_print ("VLM result cache: %zu entries, hits=%llu (+%llu from Redis) "
+        "misses=%llu evictions=%llu\n", stats.entries,
+        (unsigned long long) stats.hits,
+        (unsigned long long) dsexample->vlm_cache_remote_hits.load (),
+        (unsigned long long) (stats.misses -
+            dsexample->vlm_cache_remote_hits.load ()),
+        (unsigned long long) stats.evictions);
+  }
+  dsexample->vlm_result_cache = nullptr;
+
+  if (dsexample->vlm_buffer_pool) {
+    FrameBufferPool::Stats stats = dsexample->vlm_buffer_pool->stats ();
+    g_print ("VLM buffer pool: %zu x %zu bytes, hits=%llu misses=%llu "
+        "high-water=%llu\n", stats.block_count, stats.block_size,
+        (unsigned long long) stats.hits, (unsigned long long) stats.misses,
+        (unsigned long long) stats.high_water);
+  }
+  dsexample->vlm_buffer_pool = nullptr;
+
+  if (dsexample->vlm_stream_manager) {
+    RedisConnectionPool::Stats stats =
+        dsexample->vlm_stream_manager->get_pool_stats ();
+    g_print ("Redis pool: %zu connections, %llu checkouts, %llu timeouts, "
+        "%llu reconnects\n", stats.size, (unsigned long long) stats.checkouts,
+        (unsigned long long) stats.timeouts,
+        (unsigned long long) stats.reconnects);
+  }
+  if (dsexample->vlm_stream_manager &&
+      dsexample->redis_pending_recovery_sec > 0) {
+    VLMRedisStreamManager::PendingStats stats =
+        dsexample->vlm_stream_manager->get_pending_stats ();
+    g_print ("Redis pending entries: %llu pending across %zu consumers, "
+        "%llu dead-lettered\n", (unsigned long long) stats.pending,
+        stats.consumers, (unsigned long long) stats.dead_lettered);
+  }
+  if (dsexample->vlm_stream_manager && dsexample->redis_spill_dir) {
+    RedisSpillLog::Stats stats =
+        dsexample->vlm_stream_manager->get_spill_stats ();
+    g_print ("Redis spill log: %llu spilled, %llu replayed, %llu pending, "
+        "%llu dropped\n", (unsigned long long) stats.spilled,
+        (unsigned long long) stats.replayed,
+        (unsigned long long) stats.pending,
+        (unsigned long long) stats.dropped);
+  }
+  if (dsexample->vlm_stream_manager &&
+      dsexample->vlm_stream_manager->is_cluster ()) {
+    RedisClusterClient::Stats stats =
+        dsexample->vlm_stream_manager->get_cluster_stats ();
+    g_print ("Redis cluster: %zu masters, %llu MOVED, %llu ASK, "
+        "%llu slot map refreshes, %llu failed commands\n", stats.nodes,
+        (unsigned long long) stats.moved, (unsigned long long) stats.asks,
+        (unsigned long long) stats.refreshes,
+        (unsigned long long) stats.failures);
+  }
+  if (dsexample->vlm_stream_manager &&
+      dsexample->vlm_stream_manager->is_pipelined ()) {
+    RedisPipelinedWriter::Stats stats =
+        dsexample->vlm_stream_manager->get_pipeline_stats ();
+    g_print ("Redis pipeline: %llu XADDs in %llu round trips, %llu errors\n",
+        (unsigned long long) stats.commands,
+        (unsigned long long) stats.flushes,
+        (unsigned long long) stats.errors);
+  }
+  dsexample->vlm_stream_manager = nullptr;
 
   if (dsexample->inter_buf)
     NvBufSurfaceDestroy(dsexample->inter_buf);
@@ -603,6 +1849,71 @@ error:
   return FALSE;
 }
 
+/**
+ * Scene-change gate: compare the frame's luma thumbnail with the one of
+ * the last frame sent for its source. TRUE if the difference reaches
+ * vlm-scene-threshold or vlm-scene-max-staleness-ms has passed since that
+ * frame, which then becomes the new reference.
+ */
+static gboolean
+gst_dsexample_scene_changed (GstDsExample * dsexample,
+    NvDsFrameMeta * frame_meta, const SceneThumbnail & thumbnail)
+{
+  gint64 now = g_get_monotonic_time ();
+  auto inserted = dsexample->vlm_scene_state->emplace (frame_meta->source_id,
+      VLMSceneState ());
+  VLMSceneState &state = inserted.first->second;
+  if (!inserted.second) {
+    gboolean stale = dsexample->vlm_scene_max_staleness_ms > 0 &&
+        now - state.sent_time >=
+        (gint64) dsexample->vlm_scene_max_staleness_ms * 1000;
+    double difference =
+        SceneThumbnailDifference (&thumbnail, &state.thumbnail);
+    GST_LOG_OBJECT (dsexample, "Source %u frame %u: scene difference %.2f",
+        frame_meta->source_id, frame_meta->frame_num, difference);
+    if (!stale && difference < dsexample->vlm_scene_threshold)
+      return FALSE;
+  }
+  state.thumbnail = thumbnail;
+  state.sent_time = now;
+  return TRUE;
+}
+
+/**
+ * Feed the queue's state to the adaptive sampling controller. When it
+ * updates the intervals, post the new rate of every source as a
+ * "vlm-sampling" element message.
+ */
+static void
+gst_dsexample_update_vlm_sampling (GstDsExample * dsexample)
+{
+  VLMRateController &controller = *dsexample->vlm_rate_controller;
+  VLMRateController::Signals signals;
+  signals.queue_depth = dsexample->vlm_dispatcher ?
+      dsexample->vlm_dispatcher->queue_size () :
+      dsexample->vlm_frame_queue->size ();
+  signals.queue_capacity = dsexample->vlm_queue_max_size;
+  signals.dropped = dsexample->vlm_frames_dropped.load ();
+  if (!controller.update (signals))
+    return;
+
+  double latency_ms = controller.stats ().latency_ms;
+  for (const VLMRateController::SourceRate &rate : controller.rates ()) {
+    GST_DEBUG_OBJECT (dsexample, "Source %u: VLM interval %.1f frames, "
+        "%.2f samples/s (queue %zu, latency %.0f ms)", rate.source_id,
+        rate.interval, rate.sample_rate, signals.queue_depth, latency_ms);
+    gst_element_post_message (GST_ELEMENT (dsexample),
+        gst_message_new_element (GST_OBJECT (dsexample),
+            gst_structure_new ("vlm-sampling",
+                "source-id", G_TYPE_UINT, rate.source_id,
+                "interval", G_TYPE_DOUBLE, rate.interval,
+                "frame-rate", G_TYPE_DOUBLE, rate.frame_rate,
+                "sample-rate", G_TYPE_DOUBLE, rate.sample_rate,
+                "latency-ms", G_TYPE_DOUBLE, latency_ms,
+                NULL)));
+  }
+}
+
 /**
  * Called when element recieves an input buffer from upstream element.
  */
@@ -652,31 +1963,46 @@ gst_dsexample_transform_ip (GstBaseTransform * btrans, GstBuffer * inbuf)
     guint frame_index = 0;
 
     // Increment global counter once per batch
-    // Rate limiting: only process every Nth frame
+    // Rate limiting: only process every Nth frame, or at each source's
+    // adaptive interval
     dsexample->vlm_frame_counter++;
+    if (dsexample->vlm_rate_controller)
+      gst_dsexample_update_vlm_sampling (dsexample);
     for (l_frame = batch_meta->frame_meta_list; l_frame != NULL; l_frame = l_frame->next) {
       frame_meta = (NvDsFrameMeta *) (l_frame->data);
       frame_index = frame_meta->frame_num;
       
-      if (dsexample->vlm_frame_counter % dsexample->vlm_frame_interval == 0) {
-        // Create mock frame data (no actual frame extraction)
+      gboolean sample = dsexample->vlm_rate_controller ?
+          dsexample->vlm_rate_controller->should_sample (frame_meta->source_id) :
+          dsexample->vlm_frame_counter % dsexample->vlm_frame_interval == 0;
+      if (sample) {
         VLMFrameData vlm_frame;
-        vlm_frame.width = 1920;
-        vlm_frame.height = 1080;
-        vlm_frame.timestamp = frame_meta->buf_pts;
-        vlm_frame.source_id = frame_meta->source_id;
-        vlm_frame.frame_number = frame_meta->frame_num;
-        vlm_frame.format = "RGB";
-        
-        if (dsexample->vlm_frame_queue->size() >= dsexample->vlm_queue_max_size) {
-          VLMFrameData dropped;
-          dsexample->vlm_frame_queue->try_pop(dropped);  // Drop oldest
+        gboolean unchanged = FALSE;
+        if (!gst_dsexample_extract_vlm_frame (dsexample, surface, frame_meta,
+                vlm_frame, &unchanged)) {
+          // Same scene as the last frame sent: not worth a description
+          if (unchanged) {
+            dsexample->vlm_frames_unchanged++;
+            continue;
+          }
+          GST_WARNING_OBJECT (dsexample, "Could not extract frame #%d of "
+              "source %d for VLM", frame_index, frame_meta->source_id);
+          continue;
         }
 
-        // Thread-safe push (no manual locking!)
-        dsexample->vlm_frame_queue->push(std::move(vlm_frame));
-        g_print ("Source_id=%d enqueued frame #%d to VLM queue (size=%u)\n", 
-          frame_meta->source_id, frame_index, dsexample->vlm_frame_queue->size());    
+        // Bounded push, drops the oldest frame when full (never blocks)
+        if (dsexample->vlm_dispatcher) {
+          dsexample->vlm_frames_dropped += dsexample->vlm_dispatcher->submit(
+              dsexample->vlm_dispatcher_client, std::move(vlm_frame));
+          g_print ("Source_id=%d submitted frame #%d to shared VLM dispatcher "
+            "(size=%zu)\n", frame_meta->source_id, frame_index,
+            dsexample->vlm_dispatcher->queue_size());
+          continue;
+        }
+        dsexample->vlm_frames_dropped +=
+            dsexample->vlm_frame_queue->push_drop_oldest(std::move(vlm_frame));
+        g_print ("Source_id=%d enqueued frame #%d to VLM queue (size=%zu)\n",
+          frame_meta->source_id, frame_index, dsexample->vlm_frame_queue->size());
       }
     }  
   }
@@ -690,61 +2016,426 @@ error:
   return flow_ret;
 }
 
+/**
+ * Scale/convert one frame of the batch to RGBA at processing resolution and
+ * copy it, without row padding, into a buffer from the element's pool.
+ * With the scene-change gate on, the thumbnail is taken from the mapped
+ * surface first; an unchanged frame is never copied, FALSE is returned and
+ * `unchanged` set.
+ */
+static gboolean
+gst_dsexample_extract_vlm_frame (GstDsExample * dsexample,
+    NvBufSurface * surface, NvDsFrameMeta * frame_meta,
+    VLMFrameData & vlm_frame, gboolean * unchanged)
+{
+  NvBufSurfTransform_Error err;
+  NvBufSurfTransformParams transform_params;
+  NvBufSurfTransformRect src_rect;
+  NvBufSurfTransformRect dst_rect;
+  NvBufSurface ip_surf;
+  guint batch_id = frame_meta->batch_id;
+  gint width = dsexample->processing_width;
+  gint height = dsexample->processing_height;
+  size_t row_bytes = (size_t) width * RGBA_BYTES_PER_PIXEL;
+  guint8 *src;
+  guint pitch;
+
+  ip_surf = *surface;
+  ip_surf.numFilled = ip_surf.batchSize = 1;
+  ip_surf.surfaceList = &(surface->surfaceList[batch_id]);
+
+  src_rect = {0, 0, surface->surfaceList[batch_id].width,
+      surface->surfaceList[batch_id].height};
+  dst_rect = {0, 0, (guint) width, (guint) height};
+
+  transform_params.src_rect = &src_rect;
+  transform_params.dst_rect = &dst_rect;
+  transform_params.transform_flag =
+      NVBUFSURF_TRANSFORM_FILTER | NVBUFSURF_TRANSFORM_CROP_SRC |
+      NVBUFSURF_TRANSFORM_CROP_DST;
+  transform_params.transform_filter = NvBufSurfTransformInter_Default;
+
+  err = NvBufSurfTransformSetSessionParams (&dsexample->transform_config_params);
+  if (err != NvBufSurfTransformError_Success) {
+    GST_ELEMENT_ERROR (dsexample, STREAM, FAILED,
+        ("NvBufSurfTransformSetSessionParams failed with error %d", err), (NULL));
+    return FALSE;
+  }
+
+  err = NvBufSurfTransform (&ip_surf, dsexample->inter_buf, &transform_params);
+  if (err != NvBufSurfTransformError_Success) {
+    GST_ELEMENT_ERROR (dsexample, STREAM, FAILED,
+        ("NvBufSurfTransform failed with error %d while converting buffer", err),
+        (NULL));
+    return FALSE;
+  }
+
+  if (NvBufSurfaceMap (dsexample->inter_buf, 0, 0, NVBUF_MAP_READ) != 0)
+    return FALSE;
+  if (dsexample->inter_buf->memType == NVBUF_MEM_SURFACE_ARRAY) {
+    /* Cache the mapped data for CPU access */
+    NvBufSurfaceSyncForCpu (dsexample->inter_buf, 0, 0);
+  }
+
+  src = (guint8 *) dsexample->inter_buf->surfaceList[0].mappedAddr.addr[0];
+  pitch = dsexample->inter_buf->surfaceList[0].pitch;
+
+  if (dsexample->vlm_scene_state) {
+    SceneThumbnail thumbnail;
+    SceneThumbnailFromRGB (&thumbnail, src, width, height, pitch,
+        RGBA_BYTES_PER_PIXEL);
+    if (!gst_dsexample_scene_changed (dsexample, frame_meta, thumbnail)) {
+      NvBufSurfaceUnMap (dsexample->inter_buf, 0, 0);
+      *unchanged = TRUE;
+      return FALSE;
+    }
+  }
+
+  vlm_frame.frame_buffer =
+      dsexample->vlm_buffer_pool->acquire (row_bytes * height);
+  for (gint row = 0; row < height; row++) {
+    memcpy (vlm_frame.frame_buffer.data () + row * row_bytes,
+        src + (size_t) row * pitch, row_bytes);
+  }
+
+  NvBufSurfaceUnMap (dsexample->inter_buf, 0, 0);
+
+  vlm_frame.width = width;
+  vlm_frame.height = height;
+  vlm_frame.channels = RGBA_BYTES_PER_PIXEL;
+  vlm_frame.format = VLMFrameFormat::RGBA;
+  vlm_frame.timestamp = frame_meta->buf_pts;
+  vlm_frame.source_id = frame_meta->source_id;
+  vlm_frame.frame_number = frame_meta->frame_num;
+  return TRUE;
+}
+
 static void
-gst_dsexample_vlm_worker (GstDsExample *dsexample)
+gst_dsexample_vlm_worker (GstDsExample *dsexample, guint worker_id)
 {
-  GST_INFO_OBJECT (dsexample, "VLM worker thread started");
+  GST_INFO_OBJECT (dsexample, "VLM worker thread %u started", worker_id);
+  VLMWorkerStats &stats = *dsexample->vlm_worker_stats[worker_id];
   uint32_t processed_count = 0;
   
+  VLMFrameData frame_data;
+
+  /* One frame at a time: a worker only encodes and hands the request to
+   * the HTTP client, which keeps up to vlm-max-inflight of them in flight,
+   * so waiting for more frames would only add latency */
   while (dsexample->vlm_thread_running) {
-    std::shared_ptr<VLMFrameData> frame_data = nullptr;
-    
-    auto frame_data_ptr = dsexample->vlm_frame_queue->wait_and_pop();
-    
-    if (!frame_data_ptr || !dsexample->vlm_thread_running) {
+    if (!dsexample->vlm_frame_queue->wait_and_pop(frame_data) ||
+        !dsexample->vlm_thread_running) {
       break;  // Queue terminated or shutdown requested
     }
-    
-    gst_dsexample_send_to_vlm_service(dsexample, frame_data_ptr);
+
+    auto start = std::chrono::steady_clock::now ();
+    gst_dsexample_send_to_vlm_service(dsexample, frame_data, &stats);
+    auto busy = std::chrono::steady_clock::now () - start;
+
+    stats.frames.fetch_add (1, std::memory_order_relaxed);
+    stats.busy_us.fetch_add (
+        std::chrono::duration_cast<std::chrono::microseconds> (busy).count (),
+        std::memory_order_relaxed);
     processed_count++;
   }
   
-  GST_INFO_OBJECT (dsexample, "VLM worker thread stopped after processing %u frames", processed_count);
+  GST_INFO_OBJECT (dsexample, "VLM worker thread %u stopped after processing %u frames",
+      worker_id, processed_count);
+}
+
+/**
+ * Encode a queued frame as an image data URI for the VLM request: JPEG when
+ * built with OpenCV, uncompressed BMP otherwise.
+ */
+static std::string
+gst_dsexample_encode_vlm_frame (const VLMFrameData &frame)
+{
+  if (frame.format != VLMFrameFormat::RGB &&
+      frame.format != VLMFrameFormat::RGBA)
+    throw std::runtime_error (std::string ("cannot encode ") +
+        vlm_frame_format_name (frame.format) + " frames");
+
+#ifdef WITH_OPENCV
+  cv::Mat pixels (frame.height, frame.width,
+      frame.channels == 4 ? CV_8UC4 : CV_8UC3, frame.frame_buffer.data ());
+  cv::Mat bgr;
+  cv::cvtColor (pixels, bgr,
+      frame.channels == 4 ? cv::COLOR_RGBA2BGR : cv::COLOR_RGB2BGR);
+  std::vector<uchar> jpeg;
+  cv::imencode (".jpg", bgr, jpeg, {cv::IMWRITE_JPEG_QUALITY, VLM_JPEG_QUALITY});
+  return vlm_image_data_uri ("image/jpeg",
+      std::string_view ((const char *) jpeg.data (), jpeg.size ()));
+#else
+  return vlm_image_data_uri ("image/bmp", vlm_encode_bmp (
+      frame.frame_buffer.data (), frame.width, frame.height, frame.channels));
+#endif
 }
 
+/**
+ * Write a batch of results and partial results to Redis; runs on the
+ * publisher thread, the element's own or the shared dispatcher's, so it
+ * uses nothing but the items. Every result is queued before any is waited
+ * on, so with redis-pipeline-size they share round trips. Results to share
+ * with other nodes are stored in the Redis result cache from here as well.
+ * Returns how many items could not be written.
+ */
+static size_t
+gst_dsexample_publish_vlm_results (VLMRedisStreamManager * redis,
+    std::vector<VLMPublishItem> & batch)
+{
+  std::vector<std::future<std::string>> ids;
+  size_t failed = 0;
+  ids.reserve (batch.size ());
+  for (const VLMPublishItem &item : batch) {
+    if (item.kind == VLMPublishItem::Kind::PARTIAL)
+      failed += redis->add_vlm_partial (item.frame_number, item.source_id,
+          item.text, item.model, item.tokens).empty ();
+    else
+      ids.push_back (redis->add_vlm_result_async (item.frame_number,
+          item.source_id, item.text, item.model, item.cached));
+  }
+  for (const VLMPublishItem &item : batch) {
+    if (item.share && !redis->cache_response (item.prompt_key,
+            item.image_hash, VLMCachedResult{item.text, item.model}.serialize (),
+            item.share_ttl_sec))
+      GST_WARNING ("Could not share VLM result for source %u frame %u",
+          item.source_id, item.frame_number);
+  }
+  for (std::future<std::string> &id : ids) {
+    std::string msg_id = id.get ();
+    g_print ("VLM result added to stream: %s\n", msg_id.c_str ());
+    if (msg_id.empty ())
+      failed++;
+  }
+  return failed;
+}
+
+/**
+ * Hand a result to the publisher thread. Never waits on Redis, so it is
+ * safe on the HTTP client's I/O thread. With `share`, the publisher also
+ * stores it in the Redis result cache under `image_hash`.
+ */
+static void
+gst_dsexample_queue_vlm_result (GstDsExample * dsexample,
+    const VLMFrameData & frame_data, const std::string & vlm_response,
+    const std::string & model_name, gboolean cached, gboolean share,
+    guint64 image_hash)
+{
+  if (!dsexample->vlm_publisher)
+    return;
+  VLMPublishItem item;
+  item.source_id = frame_data.source_id;
+  item.frame_number = frame_data.frame_number;
+  item.text = vlm_response;
+  item.model = model_name;
+  item.cached = cached;
+  item.share = share;
+  item.prompt_key = dsexample->vlm_cache_prompt_key;
+  item.image_hash = image_hash;
+  item.share_ttl_sec = dsexample->vlm_cache_ttl_sec;
+  dsexample->vlm_publisher->publish (std::move (item));
+}
+
+/**
+ * Queue the response generated so far for a frame whose VLM reply is
+ * still streaming; called on the HTTP client's I/O thread. Best effort: the
+ * publisher replaces a partial still queued for the frame, and drops new
+ * ones while Redis is behind.
+ */
 static void
+gst_dsexample_publish_vlm_partial(GstDsExample *dsexample,
+                                  const VLMFrameData &frame_data,
+                                  const std::string &text, size_t tokens,
+                                  const std::string &model_name)
+{
+  if (!dsexample->vlm_publisher)
+    return;
+  VLMPublishItem item;
+  item.kind = VLMPublishItem::Kind::PARTIAL;
+  item.source_id = frame_data.source_id;
+  item.frame_number = frame_data.frame_number;
+  item.text = text;
+  item.model = model_name;
+  item.tokens = tokens;
+  dsexample->vlm_publisher->publish (std::move (item));
+}
+
+/**
+ * Result cache lookup for a frame with perceptual hash `image_hash`: the
+ * nearest entry in the local cache, then with vlm-cache-redis an exact
+ * match shared by another node, which is then kept locally too.
+ */
+static std::optional<VLMCachedResult>
+gst_dsexample_lookup_vlm_cache (GstDsExample * dsexample, guint64 image_hash)
+{
+  VLMResultCache &cache = *dsexample->vlm_result_cache;
+  std::optional<VLMCachedResult> cached =
+      cache.lookup (dsexample->vlm_cache_prompt_key, image_hash);
+  if (cached || !dsexample->vlm_cache_redis || !dsexample->redis_enabled)
+    return cached;
+
+  std::optional<std::string> value;
+  auto get = [&] (VLMRedisStreamManager *redis) {
+    value = redis->get_cached_response (dsexample->vlm_cache_prompt_key,
+        image_hash);
+    return value.has_value ();
+  };
+  if (dsexample->vlm_dispatcher)
+    dsexample->vlm_dispatcher->with_redis (get);
+  else if (dsexample->vlm_stream_manager)
+    get (dsexample->vlm_stream_manager.get ());
+  if (value)
+    cached = VLMCachedResult::parse (*value);
+  if (cached) {
+    cache.insert (dsexample->vlm_cache_prompt_key, image_hash, *cached);
+    dsexample->vlm_cache_remote_hits.fetch_add (1, std::memory_order_relaxed);
+  }
+  return cached;
+}
+
+/**
+ * Encode the frame and queue its VLM request without waiting for the reply;
+ * waits only while vlm-max-inflight requests are outstanding. When the reply
+ * arrives the HTTP client's I/O thread queues the result for the publisher
+ * thread. With vlm-stream, partial results are published from there too
+ * while the reply is generated. Cache hits, requests and failed requests are
+ * counted in `stats` (if given).
+ */
+static gboolean
 gst_dsexample_send_to_vlm_service(GstDsExample *dsexample, 
-                                  std::shared_ptr<VLMFrameData> frame_data)
+                                  const VLMFrameData &frame_data,
+                                  VLMWorkerStats *stats)
 {
-  // Example placeholder:
   try {
-    if (!frame_data) {
-      g_print ("Invalid frame_data pointer");
-      return;
+    /* A frame that looks like one already answered for the same prompt
+     * reuses that answer; the backend is not asked */
+    std::shared_ptr<VLMResultCache> cache = dsexample->vlm_result_cache;
+    guint64 image_hash = 0;
+    if (cache) {
+      SceneThumbnail thumbnail;
+      SceneThumbnailFromRGB (&thumbnail, frame_data.frame_buffer.data (),
+          frame_data.width, frame_data.height,
+          frame_data.width * frame_data.channels, frame_data.channels);
+      image_hash = SceneThumbnailDHash (&thumbnail);
+      std::optional<VLMCachedResult> cached =
+          gst_dsexample_lookup_vlm_cache (dsexample, image_hash);
+      if (cached) {
+        GST_LOG_OBJECT (dsexample, "Source %u frame %u: cached VLM result",
+            frame_data.source_id, frame_data.frame_number);
+        gst_dsexample_queue_vlm_result (dsexample, frame_data,
+            cached->response, cached->model, TRUE, FALSE, 0);
+        if (stats)
+          stats->cache_hits.fetch_add (1, std::memory_order_relaxed);
+        return TRUE;
+      }
     }
 
-    // std::string vlm_response = call_vlm_service(dsexample->vlm_service_url, frame_data);
-
-    std::string vlm_response = 
-        "{ \"description\": \"A person riding a horse on a beach.\", "
-        "\"objects\": [ {\"label\": \"person\", \"confidence\": 0.98}, "
-        "{\"label\": \"horse\", \"confidence\": 0.95}, "
-        "{\"label\": \"beach\", \"confidence\": 0.90} ] }";
-
-    // Add to Redis stream
-    if (dsexample->redis_enabled && dsexample->vlm_stream_manager) {
-        std::string msg_id = dsexample->vlm_stream_manager->add_vlm_result(
-            frame_data->frame_number, 
-            frame_data->source_id, 
-            vlm_response,
-            "deepstream_vlm_v1"  // Model version
-        );
-        
-        g_print("VLM result added to stream: %s\n", msg_id.c_str());
+    VLMHttpClient &client = *dsexample->vlm_http_client;
+    std::string body =
+        client.build_request (gst_dsexample_encode_vlm_frame (frame_data));
+
+    // The request carries the pixels; only the frame's identity is kept
+    VLMFrameData frame_info;
+    frame_info.width = frame_data.width;
+    frame_info.height = frame_data.height;
+    frame_info.timestamp = frame_data.timestamp;
+    frame_info.source_id = frame_data.source_id;
+    frame_info.frame_number = frame_data.frame_number;
+
+    VLMHttpClient::PartialCallback partial;
+    if (dsexample->vlm_stream)
+      partial = [dsexample, frame_info] (const std::string &text,
+          size_t tokens, const std::string &model) {
+        gst_dsexample_publish_vlm_partial (dsexample, frame_info, text, tokens,
+            model.empty () ? VLM_RESULT_MODEL_FALLBACK : model);
+      };
+
+    std::shared_ptr<VLMRateController> rate_controller =
+        dsexample->vlm_rate_controller;
+    VLMHttpClient::Callback done =
+        [dsexample, stats, frame_info, rate_controller, cache, image_hash]
+        (VLMHttpResult result) {
+          if (rate_controller)
+            rate_controller->record_latency (result.latency);
+          if (result.ok) {
+            VLMCachedResult answer {result.content, result.model.empty () ?
+                VLM_RESULT_MODEL_FALLBACK : result.model};
+            /* Kept for later frames with a nearby hash; with
+             * vlm-cache-redis the publisher shares it with other nodes */
+            if (cache)
+              cache->insert (dsexample->vlm_cache_prompt_key, image_hash,
+                  answer);
+            gst_dsexample_queue_vlm_result (dsexample, frame_info,
+                answer.response, answer.model, FALSE,
+                cache && dsexample->vlm_cache_redis &&
+                dsexample->vlm_cache_ttl_sec > 0, image_hash);
+          } else {
+            GST_WARNING_OBJECT (dsexample, "VLM request for source %u frame "
+                "%u failed: %s", frame_info.source_id, frame_info.frame_number,
+                result.error.c_str ());
+            if (stats)
+              stats->failures.fetch_add (1, std::memory_order_relaxed);
+          }
+        };
+    /* The dispatcher's client is shared, so it tracks which requests are
+     * ours for gst_dsexample_stop to wait on */
+    bool submitted;
+    if (dsexample->vlm_dispatcher)
+      submitted = dsexample->vlm_dispatcher->submit_request (
+          dsexample->vlm_dispatcher_client, std::move (body), std::move (done),
+          std::move (partial));
+    else
+      submitted = client.submit (std::move (body), std::move (done),
+          std::move (partial));
+    if (stats) {
+      stats->requests.fetch_add (1, std::memory_order_relaxed);
+      if (!submitted)
+        stats->failures.fetch_add (1, std::memory_order_relaxed);
     }
-    
+    return submitted ? TRUE : FALSE;
   } catch (const std::exception& e) {
     GST_ERROR_OBJECT (dsexample, "VLM service error: %s", e.what());
+    return FALSE;
+  }
+}
+
+/**
+ * Wait for outstanding VLM requests to be answered, up to
+ * vlm-request-timeout-ms, then cancel the rest; then give the publisher
+ * as long again to write the queued results. Must run while the Redis
+ * publishers are still alive.
+ */
+static void
+gst_dsexample_drain_vlm_requests (GstDsExample *dsexample)
+{
+  if (dsexample->vlm_http_client) {
+    if (!dsexample->vlm_http_client->drain (
+            std::chrono::milliseconds (dsexample->vlm_request_timeout_ms)))
+      GST_WARNING_OBJECT (dsexample, "Cancelling %zu unanswered VLM requests",
+          dsexample->vlm_http_client->stats ().inflight);
+    VLMHttpClient::Stats stats = dsexample->vlm_http_client->stats ();
+    g_print ("VLM HTTP client: %llu requests, %llu failures (%llu timeouts), "
+        "%llu connections opened\n", (unsigned long long) stats.requests,
+        (unsigned long long) stats.failures,
+        (unsigned long long) stats.timeouts,
+        (unsigned long long) stats.connects);
+    dsexample->vlm_http_client = nullptr;
+  }
+
+  if (dsexample->vlm_publisher) {
+    if (!dsexample->vlm_publisher->stop (
+            std::chrono::milliseconds (dsexample->vlm_request_timeout_ms)))
+      GST_WARNING_OBJECT (dsexample, "Dropped VLM results Redis did not "
+          "take in time");
+    VLMResultPublisher::Stats stats = dsexample->vlm_publisher->stats ();
+    g_print ("VLM publisher: %llu published, %llu failed, %llu results "
+        "dropped; partials: %llu coalesced, %llu dropped\n",
+        (unsigned long long) stats.published,
+        (unsigned long long) stats.failed,
+        (unsigned long long) stats.dropped,
+        (unsigned long long) stats.partials_coalesced,
+        (unsigned long long) stats.partials_dropped);
+    dsexample->vlm_publisher = nullptr;
   }
 }
 
@@ -35,6 +35,16 @@
 #include "gstnvdsmeta.h"
 #include "dsexample_lib/dsexample_lib.h"
 #include "dsexample_lib/threadsafe_queue.h"
+#include "dsexample_lib/vlm_frame_queue.h"
+#include "dsexample_lib/fair_frame_queue.h"
+#include "dsexample_lib/latest_frame_queue.h"
+#include "dsexample_lib/frame_buffer_pool.h"
+#include "dsexample_lib/vlm_dispatcher.h"
+#include "dsexample_lib/vlm_http_client.h"
+#include "dsexample_lib/vlm_rate_controller.h"
+#include "dsexample_lib/vlm_result_cache.h"
+#include "dsexample_lib/vlm_result_publisher.h"
+#include "dsexample_lib/scene_change.h"
 #include "dsexample_lib/redis_client.h"
 
 #include <condition_variable>
@@ -42,6 +52,7 @@
 #include <thread>
 #include <vector>
 #include <queue>
+#include <unordered_map>
 #include <condition_variable>
 #include <memory>
 #include <atomic>
@@ -72,36 +83,181 @@ typedef struct _GstDsExampleClass GstDsExampleClass;
 /** Maximum batch size to be supported by dsexample. */
 #define NVDSEXAMPLE_MAX_BATCH_SIZE 1024
 
+/** Queue implementation used between transform_ip and the VLM worker. */
+typedef enum
+{
+  /** Mutex + condition variable FIFO (ThreadSafeQueue). */
+  GST_DSEXAMPLE_VLM_QUEUE_FIFO,
+  /** Fixed-capacity lock-free ring buffer, drop-oldest when full. */
+  GST_DSEXAMPLE_VLM_QUEUE_LOCKFREE,
+  /** Per-source sub-queues served by deficit round-robin. */
+  GST_DSEXAMPLE_VLM_QUEUE_FAIR,
+  /** Only the newest pending frame per source, older ones replaced. */
+  GST_DSEXAMPLE_VLM_QUEUE_LATEST,
+} GstDsExampleVlmQueuePolicy;
+
+/** Redis stream(s) VLM results are written to. */
+typedef enum
+{
+  /** Global vlm:results:stream only. */
+  GST_DSEXAMPLE_REDIS_LAYOUT_GLOBAL,
+  /** One vlm:results:{<source_id>} stream per source only. */
+  GST_DSEXAMPLE_REDIS_LAYOUT_SHARDED,
+  /** Both the global and the per-source streams. */
+  GST_DSEXAMPLE_REDIS_LAYOUT_BOTH,
+} GstDsExampleRedisStreamLayout;
+
+/** Compression of responses in compact Redis entries. */
+typedef enum
+{
+  GST_DSEXAMPLE_REDIS_COMPRESSION_NONE,
+  /** Needs a WITH_ZSTD=1 build. */
+  GST_DSEXAMPLE_REDIS_COMPRESSION_ZSTD,
+  /** Needs a WITH_LZ4=1 build. */
+  GST_DSEXAMPLE_REDIS_COMPRESSION_LZ4,
+} GstDsExampleRedisCompression;
+
 struct VLMFrameData {
-  std::vector<uint8_t> frame_data;  // Raw frame bytes
+  FrameBufferHandle frame_buffer;   // Pooled pixel storage, tightly packed rows
   uint32_t width;
   uint32_t height;
   uint32_t channels;                // 3 for RGB, 4 for RGBA
   uint64_t timestamp;               // Frame timestamp
   uint32_t source_id;               // Source stream ID
-  std::string format;               // "RGB", "RGBA", etc.
+  VLMFrameFormat format;            // RGB, RGBA, etc.
   uint32_t frame_number;
 };
 
+/** Scene-change reference of one source: the last frame sent to the VLM. */
+struct VLMSceneState {
+  SceneThumbnail thumbnail;
+  gint64 sent_time;                 // g_get_monotonic_time () when sent
+};
+typedef std::unordered_map<guint, VLMSceneState> VLMSceneStateMap;
+
+/** Counters for one VLM worker thread. A frame is answered from the cache,
+ * becomes a request, or failed to encode (frames minus the other two).
+ * Failures are counted once per request: when the client refuses it, or on
+ * the HTTP client's I/O thread when it completes. Failed Redis writes are
+ * counted by the publisher. */
+struct VLMWorkerStats {
+  std::atomic<uint64_t> frames{0};     // Taken from the queue
+  std::atomic<uint64_t> cache_hits{0}; // Answered by the result cache
+  std::atomic<uint64_t> requests{0};   // Handed to the HTTP client
+  std::atomic<uint64_t> failures{0};   // Of those requests
+  std::atomic<uint64_t> busy_us{0};    // Per frame: cache lookup, encoding and
+                                       // waiting for an in-flight slot; the
+                                       // reply is awaited on the I/O thread
+};
+
 struct _GstDsExample
 {
   GstBaseTransform base_trans;
 
   // VLM Queue and Threading
   gboolean vlm_enabled;
-  std::shared_ptr<ThreadSafeQueue<VLMFrameData>> vlm_frame_queue;
-  std::thread vlm_worker_thread;
+  GstDsExampleVlmQueuePolicy vlm_queue_policy;
+  std::shared_ptr<VLMFrameQueue<VLMFrameData>> vlm_frame_queue;
+  std::vector<std::thread> vlm_worker_threads;
+  std::vector<std::unique_ptr<VLMWorkerStats>> vlm_worker_stats;
+
+  // Process-wide dispatcher, used instead of the queue/workers above when
+  // vlm-shared-dispatcher is set
+  gboolean vlm_shared_dispatcher;
+  std::shared_ptr<VLMDispatcher<VLMFrameData>> vlm_dispatcher;
+  std::shared_ptr<VLMDispatcher<VLMFrameData>::Client> vlm_dispatcher_client;
   std::atomic<bool> vlm_thread_running;
   
   // VLM Configuration
   uint32_t vlm_queue_max_size;      // Maximum queue size
+  uint32_t vlm_source_queue_size;   // Per-source cap (fair policy)
   uint32_t vlm_frame_interval;      // Process every N frames (for rate limiting)
+  uint32_t vlm_workers;             // Worker threads draining the queue
+  uint32_t vlm_batch_size;          // Deprecated, ignored
+  uint32_t vlm_batch_timeout_ms;    // Deprecated, ignored
   uint32_t vlm_frame_counter;       // Frame counter for interval
-  gchar *vlm_service_url;           // VLM service endpoint
+  std::atomic<uint64_t> vlm_frames_dropped;  // Evicted because the queue was full
+  std::shared_ptr<FrameBufferPool> vlm_buffer_pool;  // Pixel buffers for queued frames
+  gchar *vlm_service_url;           // OpenAI-compatible chat/completions endpoint
+  gchar *vlm_model;                 // "model" of each request (NULL = server default)
+  gchar *vlm_prompt;                // Question asked about every frame
+  guint vlm_request_timeout_ms;     // Per request, queueing in the client included
+  guint vlm_max_inflight;           // Requests outstanding at once
+  gboolean vlm_stream;              // Streamed replies, partial results published
+  guint vlm_stream_flush_tokens;    // Partial result every N tokens...
+  guint vlm_stream_flush_ms;        // ...or after M ms without one
+
+  // Per-source sampling interval adapted to backend capacity, within
+  // [vlm_min_frame_interval, vlm_max_frame_interval]; replaces the fixed
+  // vlm_frame_interval when enabled
+  gboolean vlm_adaptive_interval;
+  guint vlm_min_frame_interval;
+  guint vlm_max_frame_interval;
+  guint vlm_target_latency_ms;
+  std::shared_ptr<VLMRateController> vlm_rate_controller;
+
+  // Scene-change gate: sampled frames too similar to the last one sent for
+  // their source are skipped (vlm_scene_threshold 0 = off)
+  gdouble vlm_scene_threshold;
+  guint vlm_scene_max_staleness_ms;
+  std::shared_ptr<VLMSceneStateMap> vlm_scene_state;  // Streaming thread only
+  guint64 vlm_frames_unchanged;
+
+  // Result cache: a frame whose perceptual hash is within
+  // vlm_cache_max_distance bits of an earlier frame's, asked the same
+  // prompt, reuses that frame's response (vlm_cache_size 0 = off).
+  // vlm_cache_redis shares entries with other nodes through Redis.
+  guint vlm_cache_size;
+  guint vlm_cache_max_distance;
+  guint vlm_cache_ttl_sec;
+  gboolean vlm_cache_redis;
+  std::shared_ptr<VLMResultCache> vlm_result_cache;  // Shared by all workers
+  guint64 vlm_cache_prompt_key;     // vlm_prompt_key() of prompt and model
+  std::atomic<uint64_t> vlm_cache_remote_hits;  // Found in Redis, not locally
+  std::shared_ptr<VLMHttpClient> vlm_http_client;  // Shared by all workers
+  std::shared_ptr<VLMResultPublisher> vlm_publisher;  // Writes results to Redis
 
   std::shared_ptr<VLMRedisStreamManager> vlm_stream_manager;
   gboolean redis_enabled;
 
+  // Redis endpoint: TCP host/port, or a Unix socket when set
+  gchar *redis_host;
+  guint redis_port;
+  gchar *redis_unix_socket;
+
+  // Connection tuning (0 disables the timeouts / keepalive)
+  guint redis_connect_timeout_ms;
+  guint redis_command_timeout_ms;
+  guint redis_keepalive_sec;
+  gboolean redis_tcp_nodelay;
+
+  // Pipelined XADD batching for VLM results (0 = one round trip per result)
+  guint redis_pipeline_size;
+  guint redis_pipeline_flush_us;
+
+  // Stream capping: approximate MAXLEN on every XADD and an optional
+  // background XTRIM by age (0 disables either)
+  guint redis_stream_maxlen;
+  guint redis_retention_sec;
+
+  // Dead-letter VLM results left pending this long in the consumer group
+  // (0 disables)
+  guint redis_pending_recovery_sec;
+
+  // Global and/or per-source result streams
+  GstDsExampleRedisStreamLayout redis_stream_layout;
+
+  // Redis host is a cluster seed node; commands are routed by hash slot
+  gboolean redis_cluster;
+
+  // On-disk spill log for results written while Redis is down (NULL = off)
+  gchar *redis_spill_dir;
+  guint redis_spill_max_mb;
+
+  // One MessagePack field per VLM result instead of six strings, with
+  // responses optionally compressed
+  gboolean redis_compact;
+  GstDsExampleRedisCompression redis_compression;
 
   // Context of the custom algorithm library
   DsExampleCtx *dsexamplelib_ctx;
@@ -111,6 +111,7 @@ async def get_stats():
     return ServiceStats(
         connected_clients=service_stats["connected_clients"],
         total_messages_processed=service_stats["total_messages_processed"],
+        total_partials_processed=service_stats["total_partials_processed"],
         uptime_seconds=service_stats["uptime_seconds"],
         redis_connected=service_stats["redis_connected"]
     )
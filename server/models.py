@@ -15,6 +15,8 @@ class VLMResult(BaseModel):
     model_name: str = "default"
     timestamp: int
     type: str = "vlm_result"
+    tokens: Optional[int] = None  # vlm_partial only: tokens generated so far
+    cached: bool = False  # reused from an earlier, near-identical frame
 
 
 class HealthResponse(BaseModel):
@@ -32,5 +34,6 @@ class ServiceStats(BaseModel):
     """Basic service statistics"""
     connected_clients: int
     total_messages_processed: int
+    total_partials_processed: int = 0
     uptime_seconds: int
     redis_connected: bool
\ No newline at end of file
@@ -0,0 +1,100 @@
+"""
+vlm_codec.py - Decoder for compact VLM result stream entries
+
+Mirrors VLMResultCodec in deepstream/plugins/gst-dsexample/dsexample_lib/
+vlm_result_codec.h. A compact entry has a single "vlm" field holding the
+MessagePack array
+    [version, frame_number, source_id, model_id, compression, raw_len, response]
+Model ids resolve through the vlm:models hash (id -> name); the timestamp
+is the millisecond part of the stream ID.
+"""
+
+from typing import Dict, Optional
+
+try:
+    import zstandard
+except ImportError:  # zstd-compressed entries cannot be decoded
+    zstandard = None
+
+try:
+    import lz4.block
+except ImportError:  # lz4-compressed entries cannot be decoded
+    lz4 = None
+
+COMPACT_FIELD = "vlm"
+MODEL_TABLE = "vlm:models"
+VERSION = 1
+
+COMPRESSION_NONE = 0
+COMPRESSION_ZSTD = 1
+COMPRESSION_LZ4 = 2
+
+
+class _Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def byte(self) -> int:
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def take(self, n: int) -> bytes:
+        if self.pos + n > len(self.data):
+            raise ValueError("truncated entry")
+        chunk = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return chunk
+
+    def uint(self) -> int:
+        tag = self.byte()
+        if tag < 0x80:
+            return tag
+        width = {0xcc: 1, 0xcd: 2, 0xce: 4, 0xcf: 8}.get(tag)
+        if width is None:
+            raise ValueError(f"expected uint, got tag {tag:#x}")
+        return int.from_bytes(self.take(width), "big")
+
+    def bin(self) -> bytes:
+        tag = self.byte()
+        width = {0xc4: 1, 0xc5: 2, 0xc6: 4}.get(tag)
+        if width is None:
+            raise ValueError(f"expected bin, got tag {tag:#x}")
+        return self.take(int.from_bytes(self.take(width), "big"))
+
+
+def _decompress(compression: int, data: bytes, raw_len: int) -> bytes:
+    if compression == COMPRESSION_NONE:
+        return data
+    if compression == COMPRESSION_ZSTD and zstandard is not None:
+        return zstandard.ZstdDecompressor().decompress(data, max_output_size=raw_len)
+    if compression == COMPRESSION_LZ4 and lz4 is not None:
+        return lz4.block.decompress(data, uncompressed_size=raw_len)
+    raise ValueError(f"unsupported compression {compression}")
+
+
+def decode_entry(msg_id: str, blob: bytes, models: Optional[Dict[int, str]] = None) -> Dict[str, str]:
+    """Expand a compact entry into the fields of the plain encoding"""
+    reader = _Reader(blob)
+    if reader.byte() != 0x97:
+        raise ValueError("not a compact VLM entry")
+    version = reader.uint()
+    if version != VERSION:
+        raise ValueError(f"unknown compact entry version {version}")
+    frame_number = reader.uint()
+    source_id = reader.uint()
+    model_id = reader.uint()
+    compression = reader.uint()
+    raw_len = reader.uint()
+    response = _decompress(compression, reader.bin(), raw_len)
+
+    models = models or {}
+    return {
+        "frame_number": str(frame_number),
+        "source_id": str(source_id),
+        "vlm_response": response.decode("utf-8", errors="replace"),
+        "model_name": models.get(model_id, f"#{model_id}"),
+        "timestamp": msg_id.split("-", 1)[0],
+        "type": "vlm_result",
+    }
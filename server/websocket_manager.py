@@ -14,6 +14,7 @@ import redis.asyncio as redis
 from fastapi import WebSocket, WebSocketDisconnect
 
 from models import VLMResult
+from vlm_codec import COMPACT_FIELD, MODEL_TABLE, decode_entry
 
 logger = logging.getLogger(__name__)
 
@@ -80,8 +81,12 @@ class VLMWebSocketService:
         self.is_running = False
         self.stream_name = "vlm:results:stream"  # Match C++ VLMRedisStreamManager
         self.last_id = "$"
+        self.partial_stream_name = "vlm:results:partial"  # Responses still being generated (vlm-stream)
+        self.partial_last_id = "$"
+        self.models: Dict[int, str] = {}  # vlm:models, id -> name, for compact entries
         self.stats = {
             "total_messages_processed": 0,
+            "total_partials_processed": 0,
             "service_start_time": time.time()
         }
         
@@ -110,7 +115,7 @@ class VLMWebSocketService:
             self.redis_client = redis.Redis(
                 host=self.redis_host,
                 port=self.redis_port,
-                decode_responses=True
+                decode_responses=False  # compact entries are binary; fields decoded per entry
             )
             await self.redis_client.ping()
             logger.info(f"✅ Connected to Redis at {self.redis_host}:{self.redis_port}")
@@ -141,18 +146,25 @@ class VLMWebSocketService:
                         await asyncio.sleep(5)
                         continue
                 
-                # Read new messages from Redis stream
+                # Read new messages from Redis streams; partials first, so a
+                # frame's final result is never followed by one of its partials
                 messages = await self.redis_client.xread(
-                    {self.stream_name: self.last_id},
+                    {self.partial_stream_name: self.partial_last_id, self.stream_name: self.last_id},
                     block=1000,
                     count=10
                 )
                 
                 if messages:
                     for stream, msgs in messages:
+                        partial = stream.decode() == self.partial_stream_name
                         for msg_id, fields in msgs:
-                            await self.process_vlm_message(msg_id, fields)
-                            self.last_id = msg_id
+                            msg_id = msg_id.decode()
+                            if partial:
+                                await self.process_partial_message(msg_id, fields)
+                                self.partial_last_id = msg_id
+                            else:
+                                await self.process_vlm_message(msg_id, fields)
+                                self.last_id = msg_id
                 
             except redis.ConnectionError:
                 logger.error("🔴 Redis connection lost, reconnecting...")
@@ -162,9 +174,31 @@ class VLMWebSocketService:
                 logger.error(f"❌ Stream processing error: {e}")
                 await asyncio.sleep(1)
     
-    async def process_vlm_message(self, msg_id: str, fields: Dict[str, str]):
+    async def load_models(self):
+        """Reload the model table used by compact entries"""
+        table = await self.redis_client.hgetall(MODEL_TABLE)
+        self.models = {int(model_id): name.decode() for model_id, name in table.items()}
+    
+    async def decode_fields(self, msg_id: str, raw_fields: Dict[bytes, bytes]) -> Dict[str, str]:
+        """Decode entry fields; compact entries are expanded to the plain field set"""
+        blob = raw_fields.get(COMPACT_FIELD.encode())
+        if blob is None:
+            return {key.decode(): value.decode("utf-8", errors="replace") for key, value in raw_fields.items()}
+        fields = decode_entry(msg_id, blob, self.models)
+        if fields["model_name"].startswith("#"):  # model registered after our last reload
+            await self.load_models()
+            fields = decode_entry(msg_id, blob, self.models)
+        cached = raw_fields.get(b"cached")  # written beside the blob, not inside it
+        if cached is not None:
+            fields["cached"] = cached.decode()
+        return fields
+    
+    async def process_vlm_message(self, msg_id: str, raw_fields: Dict[bytes, bytes]):
         """Process VLM message and broadcast to clients"""
+        fields = raw_fields
         try:
+            fields = await self.decode_fields(msg_id, raw_fields)
+            
             # Parse VLM result using exact DeepStream field mapping
             vlm_result = VLMResult(
                 message_id=msg_id,
@@ -173,7 +207,8 @@ class VLMWebSocketService:
                 vlm_response=self.get_field_value(fields, "vlm_response", ""),
                 model_name=self.get_field_value(fields, "model_name", "default"),
                 timestamp=int(self.get_field_value(fields, "timestamp", str(int(time.time() * 1000)))),
-                type=fields.get('type', 'vlm_result')
+                type=fields.get('type', 'vlm_result'),
+                cached=fields.get("cached") == "1"
             )
             
             # Create WebSocket message
@@ -194,6 +229,25 @@ class VLMWebSocketService:
             logger.error(f"❌ Error processing VLM message {msg_id}: {e}")
             logger.error(f"❌ DeepStream fields: {fields}")  # Show fields only on error
     
+    async def process_partial_message(self, msg_id: str, raw_fields: Dict[bytes, bytes]):
+        """Broadcast the response generated so far for a frame still being described"""
+        fields = {key.decode(): value.decode("utf-8", errors="replace") for key, value in raw_fields.items()}
+        try:
+            partial = VLMResult(
+                message_id=msg_id,
+                frame_number=int(self.get_field_value(fields, "frame_number", "0")),
+                source_id=int(self.get_field_value(fields, "source_id", "0")),
+                vlm_response=self.get_field_value(fields, "vlm_response", ""),
+                model_name=self.get_field_value(fields, "model_name", "default"),
+                timestamp=int(self.get_field_value(fields, "timestamp", str(int(time.time() * 1000)))),
+                type="vlm_partial",
+                tokens=int(fields.get("tokens", "0"))
+            )
+            await self.manager.broadcast(json.dumps({"type": "vlm_partial", "data": partial.dict()}))
+            self.stats["total_partials_processed"] += 1
+        except Exception as e:
+            logger.error(f"❌ Error processing partial VLM message {msg_id}: {e}")
+    
     async def stop_streaming(self):
         """Stop streaming VLM data"""
         logger.info("🛑 Stopping VLM stream monitoring")
@@ -205,6 +259,7 @@ class VLMWebSocketService:
         return {
             "connected_clients": self.manager.get_connection_count(),
             "total_messages_processed": self.stats["total_messages_processed"],
+            "total_partials_processed": self.stats["total_partials_processed"],
             "uptime_seconds": int(current_time - self.stats["service_start_time"]),
             "redis_connected": self.redis_client is not None
         }
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+mock_vlm_server.py - Stand-in OpenAI-compatible VLM backend for testing
+
+Answers POST /v1/chat/completions like vLLM/SGLang/Ollama would, after a
+configurable delay, without a GPU or a model. Keeps HTTP/1.1 connections
+alive and serves every connection on its own thread, so it can be used to
+check that dsexample reuses connections and keeps many requests in flight.
+
+Usage:
+    python3 mock_vlm_server.py --port 8000 --latency-ms 500
+    gst-launch-1.0 ... dsexample vlm-service-url=http://localhost:8000/v1/chat/completions
+
+Requests with "stream": true are answered as server-sent events, one
+chat.completion.chunk per word every --token-ms after the first, closed
+by "data: [DONE]", the way vLLM streams:
+
+    python3 mock_vlm_server.py --latency-ms 100 --token-ms 40
+
+GET /stats reports requests served, connections accepted and the peak
+number of concurrent requests.
+"""
+
+import argparse
+import base64
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+_lock = threading.Lock()
+_stats = {"requests": 0, "connections": 0, "inflight": 0, "peak_inflight": 0}
+
+
+def _image_bytes(body: dict) -> int:
+    """Decoded size of the first data-URI image in the request, 0 if none"""
+    for message in body.get("messages", []):
+        content = message.get("content")
+        if not isinstance(content, list):
+            continue
+        for part in content:
+            url = part.get("image_url", {}).get("url", "") if part.get("type") == "image_url" else ""
+            if url.startswith("data:") and "," in url:
+                return len(base64.b64decode(url.split(",", 1)[1]))
+    return 0
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep-alive
+
+    def setup(self):
+        super().setup()
+        with _lock:
+            _stats["connections"] += 1
+
+    def log_message(self, format, *args):
+        if self.server.verbose:
+            super().log_message(format, *args)
+
+    def _reply(self, status: int, payload: dict):
+        data = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def _stream(self, request: dict, content: str):
+        """Send `content` word by word as chat.completion.chunk events"""
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Transfer-Encoding", "chunked")
+        self.end_headers()
+
+        chunk_id = f"chatcmpl-mock-{_stats['requests']}"
+        model = request.get("model", "mock-vlm")
+
+        def send(data: str):
+            event = f"data: {data}\n\n".encode()
+            self.wfile.write(f"{len(event):x}\r\n".encode() + event + b"\r\n")
+            self.wfile.flush()
+
+        def chunk(delta: dict, finish_reason=None):
+            send(json.dumps({
+                "id": chunk_id,
+                "object": "chat.completion.chunk",
+                "created": int(time.time()),
+                "model": model,
+                "choices": [{"index": 0, "delta": delta, "finish_reason": finish_reason}],
+            }))
+
+        chunk({"role": "assistant"})
+        words = content.split(" ")
+        for i, word in enumerate(words):
+            if i > 0:
+                time.sleep(self.server.args.token_ms / 1000)
+            chunk({"content": word if i == 0 else " " + word})
+        chunk({}, "stop")
+        send("[DONE]")
+        self.wfile.write(b"0\r\n\r\n")
+
+    def do_GET(self):
+        if self.path == "/stats":
+            with _lock:
+                self._reply(200, dict(_stats))
+        else:
+            self._reply(404, {"error": "not found"})
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        if not self.path.endswith("/chat/completions"):
+            self._reply(404, {"error": "not found"})
+            return
+        try:
+            request = json.loads(body)
+        except ValueError:
+            self._reply(400, {"error": "invalid JSON"})
+            return
+
+        with _lock:
+            _stats["requests"] += 1
+            _stats["inflight"] += 1
+            _stats["peak_inflight"] = max(_stats["peak_inflight"], _stats["inflight"])
+        try:
+            args = self.server.args
+            time.sleep(max(0.0, args.latency_ms + random.uniform(-args.jitter_ms, args.jitter_ms)) / 1000)
+            if random.random() < args.fail_rate:
+                self._reply(503, {"error": "overloaded"})
+                return
+            image_bytes = _image_bytes(request)
+            content = f"A mock description of a {image_bytes}-byte image."
+            if request.get("stream"):
+                self._stream(request, content)
+                return
+            self._reply(200, {
+                "id": f"chatcmpl-mock-{_stats['requests']}",
+                "object": "chat.completion",
+                "created": int(time.time()),
+                "model": request.get("model", "mock-vlm"),
+                "choices": [{
+                    "index": 0,
+                    "message": {
+                        "role": "assistant",
+                        "content": content,
+                    },
+                    "finish_reason": "stop",
+                }],
+                "usage": {"prompt_tokens": 0, "completion_tokens": 0, "total_tokens": 0},
+            })
+        finally:
+            with _lock:
+                _stats["inflight"] -= 1
+
+
+class Server(ThreadingHTTPServer):
+    daemon_threads = True
+    request_queue_size = 128  # listen backlog; clients open many connections at once
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--latency-ms", type=float, default=300,
+                        help="time to answer each request (to the first token when streaming)")
+    parser.add_argument("--jitter-ms", type=float, default=0, help="+/- random spread of the latency")
+    parser.add_argument("--token-ms", type=float, default=30, help="time between streamed tokens")
+    parser.add_argument("--fail-rate", type=float, default=0, help="fraction of requests answered with 503")
+    parser.add_argument("--verbose", action="store_true", help="log every request")
+    args = parser.parse_args()
+
+    server = Server((args.host, args.port), Handler)
+    server.args = args
+    server.verbose = args.verbose
+    print(f"Mock VLM server on http://{args.host}:{args.port}/v1/chat/completions "
+          f"({args.latency_ms:.0f} ms per request)")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()